@@ -15,8 +15,128 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>  // For sort, find, etc.
+#include <numeric>    // accumulate (the #include inside main relies on this one)
+#include <memory>     // Matrix below
+#include <new>
+#include <cstddef>
 using namespace std;
 
+// ==========================================
+// MATRIX - one aligned block instead of a pointer per row
+// ==========================================
+// Same Matrix as lesson 18 (memory management), for dense fixed-size grids.
+// `n` elements `step` apart: a matrix row, column, or diagonal.
+template <class T>
+struct Strided {
+    T* p;
+    size_t n;
+    ptrdiff_t step;
+    T& operator[](size_t i) const { return p[i * step]; }
+    size_t size() const { return n; }
+
+    struct iterator {
+        T* p;
+        ptrdiff_t step;
+        T& operator*() const { return *p; }
+        iterator& operator++() { p += step; return *this; }
+        bool operator!=(const iterator& o) const { return p != o.p; }
+    };
+    iterator begin() const { return {p, step}; }
+    iterator end() const { return {p + n * step, step}; }
+};
+
+// Non-owning window into a Matrix: element (i, j) is p[i*rs + j*cs]. Sub-
+// views may skip rows/columns (rstep, cstep), so v[i][j] works on every
+// other row of a block, a transpose, etc. without copying.
+template <class T>
+struct MatrixView {
+    T* p;
+    size_t rows, cols;
+    ptrdiff_t rs, cs;
+
+    T& operator()(size_t i, size_t j) const { return p[i * rs + j * cs]; }
+    Strided<T> operator[](size_t i) const { return row(i); }
+    Strided<T> row(size_t i) const { return {p + i * rs, cols, cs}; }
+    Strided<T> col(size_t j) const { return {p + j * cs, rows, rs}; }
+    MatrixView sub(size_t r0, size_t c0, size_t nr, size_t nc, size_t rstep = 1, size_t cstep = 1) const {
+        return {p + r0 * rs + c0 * cs, nr, nc, rs * (ptrdiff_t)rstep, cs * (ptrdiff_t)cstep};
+    }
+    MatrixView transposed() const { return {p, cols, rows, cs, rs}; }
+};
+
+// rows x cols elements, row-major in one 64-byte-aligned allocation. m[i]
+// is a plain T* to row i, and begin()/end() cover all elements in order,
+// so full scans are a single flat loop the compiler can vectorize.
+// Move-only: copies are explicit with clone().
+template <class T>
+class Matrix {
+public:
+    static constexpr size_t ALIGN = 64;
+
+    Matrix() {}
+    Matrix(size_t rows, size_t cols, const T& init = T()) : r(rows), c(cols) {
+        p = (T*)::operator new(max<size_t>(r * c, 1) * sizeof(T), align_val_t(ALIGN));
+        try {
+            uninitialized_fill_n(p, r * c, init);
+        } catch (...) {  // elements built so far are already destroyed
+            ::operator delete(p, align_val_t(ALIGN));
+            throw;
+        }
+    }
+    ~Matrix() { release(); }
+    Matrix(Matrix&& o) noexcept : p(o.p), r(o.r), c(o.c) { o.p = nullptr, o.r = o.c = 0; }
+    Matrix& operator=(Matrix&& o) noexcept {
+        if (this != &o) release(), p = o.p, r = o.r, c = o.c, o.p = nullptr, o.r = o.c = 0;
+        return *this;
+    }
+    Matrix(const Matrix&) = delete;
+    Matrix& operator=(const Matrix&) = delete;
+    Matrix clone() const {
+        Matrix m(r, c);
+        copy(begin(), end(), m.begin());
+        return m;
+    }
+
+    size_t rows() const { return r; }
+    size_t cols() const { return c; }
+    size_t size() const { return r * c; }
+    // Through a const Matrix& everything is read-only: const T*, MatrixView<const T>.
+    T* data() { return p; }
+    const T* data() const { return p; }
+    T* begin() { return p; }
+    T* end() { return p + r * c; }
+    const T* begin() const { return p; }
+    const T* end() const { return p + r * c; }
+
+    T* operator[](size_t i) { return p + i * c; }
+    const T* operator[](size_t i) const { return p + i * c; }
+    T& operator()(size_t i, size_t j) { return p[i * c + j]; }
+    const T& operator()(size_t i, size_t j) const { return p[i * c + j]; }
+    MatrixView<T> view() { return {p, r, c, (ptrdiff_t)c, 1}; }
+    MatrixView<const T> view() const { return {p, r, c, (ptrdiff_t)c, 1}; }
+    Strided<T> row(size_t i) { return view().row(i); }
+    Strided<const T> row(size_t i) const { return view().row(i); }
+    Strided<T> col(size_t j) { return view().col(j); }
+    Strided<const T> col(size_t j) const { return view().col(j); }
+    MatrixView<T> sub(size_t r0, size_t c0, size_t nr, size_t nc, size_t rstep = 1, size_t cstep = 1) {
+        return view().sub(r0, c0, nr, nc, rstep, cstep);
+    }
+    MatrixView<const T> sub(size_t r0, size_t c0, size_t nr, size_t nc, size_t rstep = 1, size_t cstep = 1) const {
+        return view().sub(r0, c0, nr, nc, rstep, cstep);
+    }
+
+private:
+    T* p = nullptr;
+    size_t r = 0, c = 0;
+
+    void release() {
+        if (!p) return;
+        destroy_n(p, r * c);
+        ::operator delete(p, align_val_t(ALIGN));
+        p = nullptr;
+    }
+};
+
 int main() {
     // ==========================================
     // VECTOR DECLARATION & INITIALIZATION
@@ -215,6 +335,18 @@ int main() {
     int rows = 3, cols = 4;
     vector<vector<int>> matrix2(rows, vector<int>(cols, 0));  // 3x4, all 0
     
+    // Dense fixed-size grid: Matrix keeps every row in one block
+    // (vector<vector> allocates each row separately)
+    Matrix<int> grid(rows, cols, 0);  // 3x4, all 0
+    for (int i = 0; i < rows; i++)
+        for (int j = 0; j < cols; j++) grid[i][j] = i + j;
+    cout << "grid[2][3] = " << grid[2][3] << endl;  // 5
+    int total = 0;
+    for (int val : grid) total += val;  // All elements, row by row
+    cout << "grid sum: " << total << ", column 1: ";
+    for (int val : grid.col(1)) cout << val << " ";
+    cout << endl;
+    
     // Initialize with values
     vector<vector<int>> matrix3 = {
         {1, 2, 3},
@@ -14,25 +14,564 @@
 
 #include <iostream>
 #include <memory>  // For smart pointers
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <algorithm>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#ifdef ALLOC_PROFILE
+#include <cstdlib>
+#include <cerrno>
+#include <csignal>
+#include <execinfo.h>  // backtrace
+#include <malloc.h>    // malloc_usable_size
+#include <unistd.h>
+#endif
 using namespace std;
 
+#ifdef ALLOC_PROFILE
+// ==========================================
+// ALLOCATION PROFILER - g++ -DALLOC_PROFILE -rdynamic 18_memory_management.cpp
+// ==========================================
+// Replaces the global operator new/delete (all forms) with malloc/free
+// plus bookkeeping, so leaks and hot allocation sites show up without
+// valgrind. Per thread it keeps:
+//   allocs, frees and bytes requested, with a histogram of sizes by power of two
+//   live bytes and their peak, counted as what the heap really holds (see
+//   heldBytes), so blocks need no size header - a header would push sizes
+//   near a malloc size class into the next one
+// About one allocation per SAMPLE_BYTES allocated records its call stack
+// (the top frames are operator new itself).
+// The report goes to stderr at exit and on `kill -USR1 <pid>` (call
+// stacks then as raw addresses).
+// Live bytes are per thread: memory freed on another thread moves between
+// them, and only the sum over all threads is exact.
+namespace allocprof {
+constexpr int MAX_THREADS = 256, BUCKETS = 48, MAX_FRAMES = 16, SITES = 1024;
+constexpr int SAMPLE_SHIFT = 22;  // a backtrace costs a few us in a busy program: one per 4 MB
+constexpr long long SAMPLE_BYTES = 1LL << SAMPLE_SHIFT;
+
+struct alignas(64) ThreadStats {
+    atomic<uint64_t> frees, bytes, live, peak;  // live: 2's complement
+    atomic<uint64_t> sizes[BUCKETS];            // allocs by size; they sum to the alloc count
+};
+// Zero-initialized before any constructor runs. Threads past MAX_THREADS
+// share the last slot (with atomic adds).
+ThreadStats threads[MAX_THREADS + 1];
+atomic<int> nextSlot;
+
+struct Site {
+    atomic<uint64_t> key;  // 0 empty, 1 being filled, else hash of the stack
+    void* frames[MAX_FRAMES];
+    int depth;
+    atomic<uint64_t> samples;
+};
+Site sites[SITES];
+
+thread_local ThreadStats* mine;
+thread_local bool shared, busy;  // busy: taking a sample, don't sample again
+
+inline ThreadStats& slot() {
+    if (!mine) {
+        int i = nextSlot.fetch_add(1, memory_order_relaxed);
+        shared = i >= MAX_THREADS;
+        mine = &threads[shared ? MAX_THREADS : i];
+    }
+    return *mine;
+}
+// The owning thread is the only writer: plain load + store, no lock prefix.
+// Callers test `shared` once and pick the variant.
+template <bool SHARED>
+inline uint64_t add(atomic<uint64_t>& x, uint64_t v) {
+    if (SHARED) return x.fetch_add(v, memory_order_relaxed) + v;
+    uint64_t n = x.load(memory_order_relaxed) + v;
+    x.store(n, memory_order_relaxed);
+    return n;
+}
+
+// Call stack of this allocation into the site table. Cold: a few us each.
+__attribute__((noinline, cold)) inline void sample() {
+    busy = true;
+    void* fr[MAX_FRAMES + 1];
+    int depth = max(0, backtrace(fr, MAX_FRAMES + 1) - 1);  // drop sample() itself
+    uint64_t h = 1469598103934665603ULL;
+    for (int i = 0; i < depth; i++) h = (h ^ (uintptr_t)fr[i + 1]) * 1099511628211ULL;
+    h |= 2;
+    for (int i = 0; i < SITES; i++) {
+        Site& st = sites[(h + i) % SITES];
+        uint64_t k = st.key.load(memory_order_acquire);
+        if (k == 0 && st.key.compare_exchange_strong(k, 1)) {
+            memcpy(st.frames, fr + 1, depth * sizeof(void*));
+            st.depth = depth;
+            st.samples.store(1, memory_order_relaxed);
+            st.key.store(h, memory_order_release);
+            break;
+        }
+        if (k == h) {
+            st.samples.fetch_add(1, memory_order_relaxed);
+            break;
+        }
+    }
+    busy = false;
+}
+
+// Samples whenever the byte count crosses a multiple of SAMPLE_BYTES.
+template <bool SHARED>
+__attribute__((always_inline)) inline void onAlloc(ThreadStats& t, uint64_t n, uint64_t held) {
+    add<SHARED>(t.sizes[63 - __builtin_clzll(n | 1)], 1);
+    uint64_t bytes = add<SHARED>(t.bytes, n), live = add<SHARED>(t.live, held);
+    if ((int64_t)live > (int64_t)t.peak.load(memory_order_relaxed)) t.peak.store(live, memory_order_relaxed);
+    if ((bytes ^ (bytes - n)) >> SAMPLE_SHIFT && !busy) sample();
+}
+template <bool SHARED>
+__attribute__((always_inline)) inline void onFree(ThreadStats& t, uint64_t held) {
+    add<SHARED>(t.frees, 1), add<SHARED>(t.live, 0 - held);
+}
+
+#ifdef __GLIBC__
+// glibc's own entry points; malloc and free are aliases of these unless
+// another allocator (LD_PRELOAD jemalloc, tcmalloc, a sanitizer) replaced them.
+extern "C" void* __libc_malloc(size_t) __attribute__((weak));
+extern "C" void __libc_free(void*) __attribute__((weak));
+#endif
+
+// Set once Init has checked that malloc is glibc's, so its chunk header may
+// be read. Until then (and with any other allocator) heldBytes asks
+// malloc_usable_size(); both give the same number, so flipping is harmless.
+bool glibcChunks;
+
+inline bool probeGlibcChunks() {
+#ifdef __GLIBC__
+    if (!__libc_malloc || (void*)&malloc != (void*)&__libc_malloc || (void*)&free != (void*)&__libc_free)
+        return false;
+    for (size_t n : {1, 24, 100, 1000, 200000}) {  // the last one is mmapped
+        void* p = malloc(n);
+        size_t h = *(const size_t*)((uintptr_t)p - sizeof(size_t));
+        bool same = p && (h & ~(size_t)7) - (h & 2 ? 16 : 8) == malloc_usable_size(p);
+        free(p);
+        if (!same) return false;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+// Bytes the heap spends on block p, asked of malloc rather than recorded,
+// so unsized deletes (delete[] of chars, for one) need nothing stored.
+// glibc's malloc keeps the chunk size in the word before each block;
+// reading it directly skips malloc_usable_size()'s check of the next chunk,
+// a second cache line per call. The result is what malloc_usable_size()
+// returns: chunk size less the 8-byte header (16 for mmapped chunks, flag 2).
+inline uint64_t heldBytes(void* p) {
+    if (__builtin_expect(glibcChunks, 1)) {
+        size_t h = *(const size_t*)((uintptr_t)p - sizeof(size_t));  // low bits are flags
+        return (h & ~(size_t)7) - 8 - ((h & 2) << 2);
+    }
+    return malloc_usable_size(p);
+}
+
+// Plain malloc blocks, so the size classes (and glibc's tcache) are the
+// same as without the profiler. Inlined into each operator new/delete, so
+// a hook is one call deep, like the library's.
+__attribute__((always_inline)) inline void* allocate(size_t n, size_t align) noexcept {
+    void* p = align <= 16 ? malloc(n) : aligned_alloc(align, (max<size_t>(n, 1) + align - 1) / align * align);
+    if (!p) return nullptr;
+    ThreadStats& t = slot();
+    if (__builtin_expect(shared, 0)) onAlloc<true>(t, n, heldBytes(p));
+    else onAlloc<false>(t, n, heldBytes(p));
+    return p;
+}
+
+__attribute__((always_inline)) inline void release(void* p) noexcept {
+    if (!p) return;
+    ThreadStats& t = slot();
+    if (__builtin_expect(shared, 0)) onFree<true>(t, heldBytes(p));
+    else onFree<false>(t, heldBytes(p));
+    free(p);
+}
+
+// One line of report text, built with async-signal-safe steps only (no
+// printf: it may lock or allocate) and written to stderr with write() when
+// the temporary dies, so report() can run inside the SIGUSR1 handler.
+struct Line {
+    char buf[256];
+    size_t n = 0;
+
+    void put(char c) { if (n < sizeof buf) buf[n++] = c; }
+    Line& text(const char* s) { while (*s) put(*s++); return *this; }
+    // Right-aligned in `width` columns; a negative width left-aligns, as %-Nd.
+    Line& num(uint64_t v, int width = 0, bool neg = false) {
+        char d[24];
+        int k = 0;
+        do d[k++] = char('0' + v % 10); while (v /= 10);
+        if (neg) d[k++] = '-';
+        int pad = max(abs(width) - k, 0);
+        if (width > 0) while (pad--) put(' ');
+        while (k) put(d[--k]);
+        if (width < 0) while (pad--) put(' ');
+        return *this;
+    }
+    Line& snum(int64_t v, int width = 0) { return num(v < 0 ? 0 - (uint64_t)v : v, width, v < 0); }
+    Line& hex(uintptr_t v) {
+        text("0x");
+        for (int sh = 60; sh >= 0; sh -= 4) put("0123456789abcdef"[(v >> sh) & 15]);
+        return *this;
+    }
+    ~Line() { if (write(STDERR_FILENO, buf, n) < 0) {} }
+};
+
+// inSignal: call stacks as raw addresses (addr2line -e <binary> turns them
+// into lines); backtrace_symbols_fd() is not async-signal-safe.
+inline void report(bool inSignal) {
+    bool was = busy;
+    busy = true;
+    int used = min(nextSlot.load(), MAX_THREADS + 1);
+    uint64_t allocs = 0, frees = 0, bytes = 0, live = 0, sizes[BUCKETS] = {};
+    Line().text("=== allocation profile ===\n  thread     allocs      frees        bytes         live         peak\n");
+    for (int i = 0; i < used; i++) {
+        ThreadStats& t = threads[i == used - 1 && used > MAX_THREADS ? MAX_THREADS : i];
+        uint64_t a = 0, f = t.frees, b = t.bytes, l = t.live;
+        for (int k = 0; k < BUCKETS; k++) a += t.sizes[k];
+        if (i < 16)
+            Line().text("  ").num(i, 6).text(" ").num(a, 10).text(" ").num(f, 10).text(" ").num(b, 12).text(" ")
+                .snum(l, 12).text(" ").snum(t.peak.load(), 12).text("\n");
+        allocs += a, frees += f, bytes += b, live += l;
+        for (int k = 0; k < BUCKETS; k++) sizes[k] += t.sizes[k];
+    }
+    Line().text("  total  ").num(allocs, 10).text(" ").num(frees, 10).text(" ").num(bytes, 12).text(" ")
+        .snum(live, 12).text("  (").num(used).text(" threads)\n  size histogram:\n");
+    for (int k = 0; k < BUCKETS; k++)
+        if (sizes[k]) Line().text("    ").num(1ULL << k, 10).text(" - ").num((2ULL << k) - 1, -10).text(" ").num(sizes[k], 10).text("\n");
+    Line().text("  top call sites (~").num(SAMPLE_BYTES >> 10).text(" KB allocated per sample):\n");
+    bool shown[SITES] = {};
+    for (int top = 0; top < 5; top++) {
+        int best = -1;
+        for (int i = 0; i < SITES; i++)
+            if (!shown[i] && sites[i].key.load(memory_order_acquire) > 1 &&
+                (best < 0 || sites[i].samples > sites[best].samples)) best = i;
+        if (best < 0) break;
+        shown[best] = true;
+        Line().text("  #").num(top + 1).text("  ").num(sites[best].samples.load()).text(" samples\n");
+        if (!inSignal) backtrace_symbols_fd(sites[best].frames, sites[best].depth, STDERR_FILENO);
+        else for (int i = 0; i < sites[best].depth; i++) Line().text("    ").hex((uintptr_t)sites[best].frames[i]).text("\n");
+    }
+    busy = was;
+}
+
+// Standard operator new behaviour: on failure run the new_handler (which
+// may free memory) and retry; with no handler installed, throw. The loop
+// is out of line so the hit path stays inlined in operator new.
+__attribute__((noinline, cold)) inline void* retryAllocate(size_t n, size_t align) {
+    for (;;) {
+        if (new_handler h = get_new_handler()) h();
+        else throw bad_alloc();
+        if (void* p = allocate(n, align)) return p;
+    }
+}
+__attribute__((always_inline)) inline void* allocateOrThrow(size_t n, size_t align) {
+    if (void* p = allocate(n, align)) return p;
+    return retryAllocate(n, align);
+}
+
+struct Init {
+    Init() {
+        void* f[2];
+        busy = true;
+        backtrace(f, 2);  // loads libgcc now rather than inside a hook
+        busy = false;
+        glibcChunks = probeGlibcChunks();
+        signal(SIGUSR1, [](int) {
+            int e = errno;  // write() may change it under the interrupted code
+            report(true);
+            errno = e;
+        });
+        atexit([] { report(false); });
+    }
+} init;
+}  // namespace allocprof
+
+void* operator new(size_t n) { return allocprof::allocateOrThrow(n, 16); }
+void* operator new(size_t n, align_val_t a) { return allocprof::allocateOrThrow(n, (size_t)a); }
+// The nothrow forms also run the new_handler; a bad_alloc from it means null.
+void* operator new(size_t n, const nothrow_t&) noexcept {
+    try { return allocprof::allocateOrThrow(n, 16); } catch (...) { return nullptr; }
+}
+void* operator new(size_t n, align_val_t a, const nothrow_t&) noexcept {
+    try { return allocprof::allocateOrThrow(n, (size_t)a); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t n) { return operator new(n); }
+void* operator new[](size_t n, align_val_t a) { return operator new(n, a); }
+void* operator new[](size_t n, const nothrow_t& t) noexcept { return operator new(n, t); }
+void* operator new[](size_t n, align_val_t a, const nothrow_t& t) noexcept { return operator new(n, a, t); }
+void operator delete(void* p) noexcept { allocprof::release(p); }
+void operator delete(void* p, size_t) noexcept { allocprof::release(p); }
+void operator delete(void* p, align_val_t) noexcept { allocprof::release(p); }
+void operator delete(void* p, size_t, align_val_t) noexcept { allocprof::release(p); }
+void operator delete(void* p, const nothrow_t&) noexcept { allocprof::release(p); }
+void operator delete(void* p, align_val_t, const nothrow_t&) noexcept { allocprof::release(p); }
+void operator delete[](void* p) noexcept { allocprof::release(p); }
+void operator delete[](void* p, size_t) noexcept { allocprof::release(p); }
+void operator delete[](void* p, align_val_t) noexcept { allocprof::release(p); }
+void operator delete[](void* p, size_t, align_val_t) noexcept { allocprof::release(p); }
+void operator delete[](void* p, const nothrow_t&) noexcept { allocprof::release(p); }
+void operator delete[](void* p, align_val_t, const nothrow_t&) noexcept { allocprof::release(p); }
+#endif
+
+// ==========================================
+// SLAB POOL - size classes, thread-local free lists
+// ==========================================
+// Blocks of 16, 32, ..., 512 bytes carved from 64 KB slabs. Each thread
+// keeps its own free list per size class, so allocate/deallocate are a
+// pointer pop/push with no lock. A block freed on another thread joins
+// that thread's list. A list holds at most LIST_SLABS slabs' worth; past
+// that, one slab's worth moves as a batch to a locked global list per
+// class, which refill() takes from before carving a new slab. A consumer
+// thread freeing what a producer allocates therefore hands the blocks
+// back instead of hoarding them. Freed blocks are never returned to the
+// OS before exit. Bigger requests go to ::operator new.
+class SlabPool {
+public:
+    static constexpr int CLASSES = 6;
+    static constexpr size_t MAX_BLOCK = 512, SLAB_BYTES = 64 << 10, LIST_SLABS = 2;
+
+    static int classOf(size_t bytes) { return bytes <= 16 ? 0 : 60 - __builtin_clzll(bytes - 1); }
+    static size_t blockSize(int c) { return (size_t)16 << c; }
+    static size_t perSlab(int c) { return SLAB_BYTES >> 4 >> c; }  // SLAB_BYTES / blockSize(c)
+
+    static void* allocate(size_t bytes) {
+        if (bytes > MAX_BLOCK) return ::operator new(bytes);
+        Cache& tc = cache();
+        int c = classOf(bytes);
+        Cache::List& l = tc.lists[c];
+        bump(tc.counts[c].allocs), bump(tc.counts[c].requested, bytes);
+        if (Block* b = l.free) {
+            l.free = b->next;
+            bump(tc.counts[c].hits);
+            return b;
+        }
+        return tc.refill(c);
+    }
+
+    static void deallocate(void* p, size_t bytes) {
+        if (!p) return;
+        if (bytes > MAX_BLOCK) return ::operator delete(p);
+        Cache& tc = cache();
+        int c = classOf(bytes);
+        Cache::List& l = tc.lists[c];
+        Block* b = (Block*)p;
+        b->next = l.free;
+        l.free = b;
+        uint64_t frees = bump(tc.counts[c].frees);
+        bump(tc.counts[c].requested, 0 - bytes);
+        if (__builtin_expect(frees % 64 == 0, 0)) tc.trim(c);  // overshoots the cap by < 64 blocks
+    }
+
+    // Totals over all threads, live and exited.
+    struct ClassStats {
+        uint64_t allocs = 0, hits = 0, frees = 0, requested = 0, reserved = 0;
+        uint64_t live() const { return allocs - frees; }
+    };
+    static vector<ClassStats> stats() {
+        Global& g = global();
+        lock_guard<mutex> lk(g.mu);
+        vector<ClassStats> out(CLASSES);
+        auto add = [&](const Counts* cs) {
+            for (int c = 0; c < CLASSES; c++) {
+                out[c].allocs += cs[c].allocs.load(memory_order_relaxed);
+                out[c].hits += cs[c].hits.load(memory_order_relaxed);
+                out[c].frees += cs[c].frees.load(memory_order_relaxed);
+                out[c].requested += cs[c].requested.load(memory_order_relaxed);
+                out[c].reserved += cs[c].reserved.load(memory_order_relaxed);
+            }
+        };
+        add(g.retired);
+        for (Cache* tc : g.caches) add(tc->counts);
+        return out;
+    }
+
+    // hit% = allocations served from a free list. internal = bytes lost to
+    // rounding up live requests; unused = reserved slab bytes not in use.
+    static void report() {
+        vector<ClassStats> st = stats();
+        printf("  %6s %10s %6s %8s %9s %9s %7s\n", "block", "allocs", "hit%", "live", "reserved", "internal", "unused");
+        for (int c = 0; c < CLASSES; c++) {
+            const ClassStats& s = st[c];
+            if (!s.allocs) continue;
+            double inUse = (double)s.live() * blockSize(c);
+            printf("  %6zu %10llu %5.1f%% %8llu %8lluK %8.1f%% %6.1f%%\n", blockSize(c),
+                   (unsigned long long)s.allocs, 100.0 * s.hits / s.allocs, (unsigned long long)s.live(),
+                   (unsigned long long)s.reserved >> 10, inUse ? 100 * (1 - s.requested / inUse) : 0.0,
+                   s.reserved ? 100 * (1 - inUse / s.reserved) : 0.0);
+        }
+    }
+
+private:
+    struct Block { Block* next; };
+
+    // Written only by the owning thread (plain load + store, no lock
+    // prefix); atomic so stats() may read them from another thread.
+    struct Counts { atomic<uint64_t> allocs{0}, hits{0}, frees{0}, requested{0}, reserved{0}; };
+    static uint64_t bump(atomic<uint64_t>& x, uint64_t by = 1) {
+        uint64_t v = x.load(memory_order_relaxed) + by;
+        x.store(v, memory_order_relaxed);
+        return v;
+    }
+
+    // Free blocks no thread holds: batches spilled by full lists and the
+    // lists of exited threads. n mirrors batches.size() so an empty check
+    // needs no lock.
+    struct Spare {
+        mutex mu;
+        vector<pair<Block*, size_t>> batches;  // chain head, length
+        atomic<size_t> n{0};
+        void push(Block* head, size_t len) {
+            lock_guard<mutex> lk(mu);
+            batches.push_back({head, len});
+            n.store(batches.size(), memory_order_relaxed);
+        }
+        pair<Block*, size_t> pop() {
+            if (!n.load(memory_order_relaxed)) return {nullptr, 0};
+            lock_guard<mutex> lk(mu);
+            if (batches.empty()) return {nullptr, 0};
+            pair<Block*, size_t> b = batches.back();
+            batches.pop_back();
+            n.store(batches.size(), memory_order_relaxed);
+            return b;
+        }
+    };
+
+    struct Cache;
+    struct Global {
+        mutex mu;
+        vector<Cache*> caches;
+        vector<void*> slabs;
+        Counts retired[CLASSES];
+        Spare spare[CLASSES];
+        ~Global() { for (void* s : slabs) ::operator delete(s); }
+    };
+    static Global& global() { static Global g; return g; }
+
+    struct Cache {
+        // emptyAt: frees - hits when the list was last empty, adjusted
+        // for spilled and adopted batches, so the length needs no counter
+        // of its own on the hot path.
+        struct List { Block* free = nullptr; uint64_t emptyAt = 0; char *cur = nullptr, *end = nullptr; };
+        List lists[CLASSES];
+        Counts counts[CLASSES];
+
+        size_t length(int c) const {
+            return counts[c].frees.load(memory_order_relaxed) - counts[c].hits.load(memory_order_relaxed) -
+                   lists[c].emptyAt;
+        }
+
+        Cache() {
+            Global& g = global();
+            lock_guard<mutex> lk(g.mu);
+            g.caches.push_back(this);
+        }
+        ~Cache() {
+            Global& g = global();
+            lock_guard<mutex> lk(g.mu);
+            for (int c = 0; c < CLASSES; c++) {
+                if (lists[c].free) g.spare[c].push(lists[c].free, length(c));
+                g.retired[c].allocs += counts[c].allocs, g.retired[c].hits += counts[c].hits;
+                g.retired[c].frees += counts[c].frees, g.retired[c].requested += counts[c].requested;
+                g.retired[c].reserved += counts[c].reserved;
+            }
+            g.caches.erase(find(g.caches.begin(), g.caches.end(), this));
+        }
+
+        // Free list over its cap: hand one slab's worth to the spare list.
+        __attribute__((noinline, cold)) void trim(int c) {
+            if (length(c) <= LIST_SLABS * perSlab(c)) return;
+            List& l = lists[c];
+            size_t len = perSlab(c);
+            Block* head = l.free;
+            Block* tail = head;
+            for (size_t i = 1; i < len; i++) tail = tail->next;
+            l.free = tail->next;
+            l.emptyAt += len;
+            tail->next = nullptr;
+            global().spare[c].push(head, len);
+        }
+
+        // Free list empty: take a spare batch, else carve from this
+        // thread's slab, else take a new slab.
+        void* refill(int c) {
+            List& l = lists[c];
+            size_t bs = blockSize(c);
+            Global& g = global();
+            auto [b, len] = g.spare[c].pop();
+            if (b) {
+                l.free = b->next;
+                l.emptyAt -= len - 1;
+                return b;
+            }
+            if (l.cur == l.end) {
+                lock_guard<mutex> lk(g.mu);
+                l.cur = (char*)::operator new(SLAB_BYTES);
+                l.end = l.cur + SLAB_BYTES / bs * bs;
+                g.slabs.push_back(l.cur);
+                bump(counts[c].reserved, SLAB_BYTES);
+            }
+            void* p = l.cur;
+            l.cur += bs;
+            return p;
+        }
+    };
+    static Cache& cache() { thread_local Cache tc; return tc; }
+};
+
+// Standard allocator over SlabPool: vector<int, SlabAllocator<int>>,
+// allocate_shared<T>(SlabAllocator<T>(), ...), etc.
+template <class T>
+struct SlabAllocator {
+    static_assert(alignof(T) <= 16, "slab blocks are 16-byte aligned");
+    using value_type = T;
+    SlabAllocator() = default;
+    template <class U> SlabAllocator(const SlabAllocator<U>&) {}
+    T* allocate(size_t n) { return (T*)SlabPool::allocate(n * sizeof(T)); }
+    void deallocate(T* p, size_t n) { SlabPool::deallocate(p, n * sizeof(T)); }
+    template <class U> bool operator==(const SlabAllocator<U>&) const { return true; }
+    template <class U> bool operator!=(const SlabAllocator<U>&) const { return false; }
+};
+
 // Simple class for demonstration
+// Both the object (class operator new) and its 100-int payload come from
+// SlabPool, so creating one costs two free-list pops instead of two mallocs.
 class Resource {
 private:
     string name;
     int* data;
     
 public:
-    Resource(string n) : name(n) {
-        data = new int[100];
-        cout << "Resource '" << name << "' created" << endl;
+    static inline bool verbose = true;  // benchmarks switch the messages off
+    
+    Resource(string n) : name(move(n)) {
+        data = SlabAllocator<int>().allocate(100);  // instead of new int[100]
+        if (verbose) cout << "Resource '" << name << "' created" << endl;
     }
     
     ~Resource() {
-        delete[] data;
-        cout << "Resource '" << name << "' destroyed" << endl;
+        SlabAllocator<int>().deallocate(data, 100);
+        if (verbose) cout << "Resource '" << name << "' destroyed" << endl;
     }
     
+    static void* operator new(size_t bytes) { return SlabPool::allocate(bytes); }
+    static void operator delete(void* p, size_t bytes) { SlabPool::deallocate(p, bytes); }
+    
     void use() {
         cout << "Using resource: " << name << endl;
     }
@@ -55,7 +594,764 @@ public:
     }
 };
 
-int main() {
+// ==========================================
+// ARENA + INTRUSIVE LISTS - no refcounts, no recursive teardown
+// ==========================================
+// Bump allocator: make<T>() is a pointer increment, and everything goes at
+// once in reset() or the destructor. Destructors of non-trivial objects
+// are remembered in a list and run in a loop (newest first), so a chain of
+// 10^7 nodes is torn down without recursion. Chunks double in size; reset()
+// keeps the newest (largest) one so a build/reset cycle reuses warm memory.
+class Arena {
+public:
+    explicit Arena(size_t firstChunk = 64 << 10) : next(firstChunk) {}
+    ~Arena() { reset(); ::operator delete(blocks); }
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t align) {  // align: power of two <= 16
+        size_t at = (used + align - 1) & ~(align - 1);
+        if (!blocks || at + bytes > cap) {
+            size_t need = max(next, bytes + align + sizeof(Header));
+            Header* h = (Header*)::operator new(need);
+            h->prev = blocks, blocks = h;
+            cap = need, used = sizeof(Header);
+            at = (used + align - 1) & ~(align - 1);
+            total += need;
+            next = min(need * 2, (size_t)64 << 20);
+        }
+        used = at + bytes;
+        return (char*)blocks + at;
+    }
+
+    template <class T, class... A>
+    T* make(A&&... args) {
+        static_assert(alignof(T) <= 16, "chunks are 16-byte aligned");
+        T* p = new (allocate(sizeof(T), alignof(T))) T(forward<A>(args)...);
+        if (!is_trivially_destructible_v<T>) {
+            Dtor* d = (Dtor*)allocate(sizeof(Dtor), alignof(Dtor));
+            *d = {[](void* o) { ((T*)o)->~T(); }, p, dtors};
+            dtors = d;
+        }
+        return p;
+    }
+
+    void reset() {
+        for (Dtor* d = dtors; d; d = d->next) d->run(d->obj);
+        dtors = nullptr;
+        if (!blocks) return;
+        while (Header* prev = blocks->prev) {
+            blocks->prev = prev->prev;
+            ::operator delete(prev);
+        }
+        used = sizeof(Header), total = cap;
+    }
+    size_t bytesReserved() const { return total; }
+
+private:
+    struct alignas(16) Header { Header* prev; };
+    struct Dtor { void (*run)(void*); void* obj; Dtor* next; };
+    size_t next, used = 0, cap = 0, total = 0;
+    Header* blocks = nullptr;
+    Dtor* dtors = nullptr;
+};
+
+// Intrusive links: the node type inherits them, so a list never allocates
+// and never owns. Give a Tag to be in two lists of the same kind at once.
+template <class Tag = void> struct SLink { SLink* next = nullptr; };
+template <class Tag = void> struct DLink { DLink *prev = nullptr, *next = nullptr; };
+
+// Singly linked list over T : SLink<Tag>.
+template <class T, class Tag = void>
+class SList {
+    using Link = SLink<Tag>;
+
+public:
+    struct iterator {
+        Link* cur;
+        T& operator*() const { return static_cast<T&>(*cur); }
+        T* operator->() const { return static_cast<T*>(cur); }
+        iterator& operator++() { cur = cur->next; return *this; }
+        bool operator!=(const iterator& o) const { return cur != o.cur; }
+        bool operator==(const iterator& o) const { return cur == o.cur; }
+    };
+    iterator begin() const { return {head}; }
+    iterator end() const { return {nullptr}; }
+
+    bool empty() const { return !head; }
+    size_t size() const { return count; }
+    T& front() const { return static_cast<T&>(*head); }
+
+    void push_front(T& x) {
+        Link& l = x;
+        l.next = head, head = &l, count++;
+    }
+    void pop_front() { head = head->next, count--; }
+    void insert_after(T& pos, T& x) {
+        Link &p = pos, &l = x;
+        l.next = p.next, p.next = &l, count++;
+    }
+    void erase_after(T& pos) {
+        Link& p = pos;
+        p.next = p.next->next, count--;
+    }
+    void reverse() {
+        Link* prev = nullptr;
+        while (head) {
+            Link* next = head->next;
+            head->next = prev, prev = head, head = next;
+        }
+        head = prev;
+    }
+    void clear() { head = nullptr, count = 0; }  // nodes belong to their arena
+
+private:
+    Link* head = nullptr;
+    size_t count = 0;
+};
+
+// Doubly linked list over T : DLink<Tag>. erase() is O(1) given the node.
+template <class T, class Tag = void>
+class DList {
+    using Link = DLink<Tag>;
+
+public:
+    struct iterator {
+        Link* cur;
+        const DList* list;
+        T& operator*() const { return static_cast<T&>(*cur); }
+        T* operator->() const { return static_cast<T*>(cur); }
+        iterator& operator++() { cur = cur->next; return *this; }
+        iterator& operator--() { cur = cur ? cur->prev : list->tail; return *this; }  // --end() is back()
+        bool operator!=(const iterator& o) const { return cur != o.cur; }
+        bool operator==(const iterator& o) const { return cur == o.cur; }
+    };
+    iterator begin() const { return {head, this}; }
+    iterator end() const { return {nullptr, this}; }
+
+    bool empty() const { return !head; }
+    size_t size() const { return count; }
+    T& front() const { return static_cast<T&>(*head); }
+    T& back() const { return static_cast<T&>(*tail); }
+
+    void push_front(T& x) { link(nullptr, head, x); }
+    void push_back(T& x) { link(tail, nullptr, x); }
+    void insert_before(T& pos, T& x) { Link& p = pos; link(p.prev, &p, x); }
+    void pop_front() { erase(front()); }
+    void pop_back() { erase(back()); }
+    void erase(T& x) {
+        Link& l = x;
+        (l.prev ? l.prev->next : head) = l.next;
+        (l.next ? l.next->prev : tail) = l.prev;
+        l.prev = l.next = nullptr, count--;
+    }
+    void clear() { head = tail = nullptr, count = 0; }
+
+private:
+    Link *head = nullptr, *tail = nullptr;
+    size_t count = 0;
+
+    void link(Link* before, Link* after, T& x) {
+        Link& l = x;
+        l.prev = before, l.next = after;
+        (before ? before->next : head) = &l;
+        (after ? after->prev : tail) = &l;
+        count++;
+    }
+};
+
+// The Node example with intrusive links: in a singly and a doubly linked
+// list at the same time, memory owned by an Arena.
+struct ListNode : SLink<>, DLink<> {
+    int value;
+    explicit ListNode(int v) : value(v) {}
+};
+
+// ==========================================
+// MATRIX - one aligned block instead of a pointer per row
+// ==========================================
+// `n` elements `step` apart: a matrix row, column, or diagonal.
+template <class T>
+struct Strided {
+    T* p;
+    size_t n;
+    ptrdiff_t step;
+    T& operator[](size_t i) const { return p[i * step]; }
+    size_t size() const { return n; }
+
+    struct iterator {
+        T* p;
+        ptrdiff_t step;
+        T& operator*() const { return *p; }
+        iterator& operator++() { p += step; return *this; }
+        bool operator!=(const iterator& o) const { return p != o.p; }
+    };
+    iterator begin() const { return {p, step}; }
+    iterator end() const { return {p + n * step, step}; }
+};
+
+// Non-owning window into a Matrix: element (i, j) is p[i*rs + j*cs]. Sub-
+// views may skip rows/columns (rstep, cstep), so v[i][j] works on every
+// other row of a block, a transpose, etc. without copying.
+template <class T>
+struct MatrixView {
+    T* p;
+    size_t rows, cols;
+    ptrdiff_t rs, cs;
+
+    T& operator()(size_t i, size_t j) const { return p[i * rs + j * cs]; }
+    Strided<T> operator[](size_t i) const { return row(i); }
+    Strided<T> row(size_t i) const { return {p + i * rs, cols, cs}; }
+    Strided<T> col(size_t j) const { return {p + j * cs, rows, rs}; }
+    MatrixView sub(size_t r0, size_t c0, size_t nr, size_t nc, size_t rstep = 1, size_t cstep = 1) const {
+        return {p + r0 * rs + c0 * cs, nr, nc, rs * (ptrdiff_t)rstep, cs * (ptrdiff_t)cstep};
+    }
+    MatrixView transposed() const { return {p, cols, rows, cs, rs}; }
+};
+
+// rows x cols elements, row-major in one 64-byte-aligned allocation. m[i]
+// is a plain T* to row i, and begin()/end() cover all elements in order,
+// so full scans are a single flat loop the compiler can vectorize.
+// Move-only: copies are explicit with clone().
+template <class T>
+class Matrix {
+public:
+    static constexpr size_t ALIGN = 64;
+
+    Matrix() {}
+    Matrix(size_t rows, size_t cols, const T& init = T()) : r(rows), c(cols) {
+        p = (T*)::operator new(max<size_t>(r * c, 1) * sizeof(T), align_val_t(ALIGN));
+        try {
+            uninitialized_fill_n(p, r * c, init);
+        } catch (...) {  // elements built so far are already destroyed
+            ::operator delete(p, align_val_t(ALIGN));
+            throw;
+        }
+    }
+    ~Matrix() { release(); }
+    Matrix(Matrix&& o) noexcept : p(o.p), r(o.r), c(o.c) { o.p = nullptr, o.r = o.c = 0; }
+    Matrix& operator=(Matrix&& o) noexcept {
+        if (this != &o) release(), p = o.p, r = o.r, c = o.c, o.p = nullptr, o.r = o.c = 0;
+        return *this;
+    }
+    Matrix(const Matrix&) = delete;
+    Matrix& operator=(const Matrix&) = delete;
+    Matrix clone() const {
+        Matrix m(r, c);
+        copy(begin(), end(), m.begin());
+        return m;
+    }
+
+    size_t rows() const { return r; }
+    size_t cols() const { return c; }
+    size_t size() const { return r * c; }
+    // Through a const Matrix& everything is read-only: const T*, MatrixView<const T>.
+    T* data() { return p; }
+    const T* data() const { return p; }
+    T* begin() { return p; }
+    T* end() { return p + r * c; }
+    const T* begin() const { return p; }
+    const T* end() const { return p + r * c; }
+
+    T* operator[](size_t i) { return p + i * c; }
+    const T* operator[](size_t i) const { return p + i * c; }
+    T& operator()(size_t i, size_t j) { return p[i * c + j]; }
+    const T& operator()(size_t i, size_t j) const { return p[i * c + j]; }
+    MatrixView<T> view() { return {p, r, c, (ptrdiff_t)c, 1}; }
+    MatrixView<const T> view() const { return {p, r, c, (ptrdiff_t)c, 1}; }
+    Strided<T> row(size_t i) { return view().row(i); }
+    Strided<const T> row(size_t i) const { return view().row(i); }
+    Strided<T> col(size_t j) { return view().col(j); }
+    Strided<const T> col(size_t j) const { return view().col(j); }
+    MatrixView<T> sub(size_t r0, size_t c0, size_t nr, size_t nc, size_t rstep = 1, size_t cstep = 1) {
+        return view().sub(r0, c0, nr, nc, rstep, cstep);
+    }
+    MatrixView<const T> sub(size_t r0, size_t c0, size_t nr, size_t nc, size_t rstep = 1, size_t cstep = 1) const {
+        return view().sub(r0, c0, nr, nc, rstep, cstep);
+    }
+
+private:
+    T* p = nullptr;
+    size_t r = 0, c = 0;
+
+    void release() {
+        if (!p) return;
+        destroy_n(p, r * c);
+        ::operator delete(p, align_val_t(ALIGN));
+        p = nullptr;
+    }
+};
+
+// ==========================================
+// SLOT MAP - generation-checked handles instead of weak_ptr
+// ==========================================
+// A Handle is a slot index plus that slot's generation in one uint64_t.
+// erase() bumps the generation, so old handles stop matching: get() is
+// one compare and two loads, no control block and no atomics. Values are
+// kept packed in a vector (erase moves the last one into the hole), so
+// iterating is a plain array scan.
+// Not synchronized: many threads may get() at once, but insert/erase need
+// the map to themselves. Handle{} is never valid.
+template <class T>
+class SlotMap {
+public:
+    struct Handle {
+        uint64_t bits = 0;
+        uint32_t index() const { return (uint32_t)bits; }
+        uint32_t generation() const { return (uint32_t)(bits >> 32); }
+        bool operator==(Handle o) const { return bits == o.bits; }
+        bool operator!=(Handle o) const { return bits != o.bits; }
+    };
+
+    // Strong guarantee: if T's constructor (or an allocation) throws, the
+    // map is unchanged. Everything that can throw happens before the slot
+    // is taken off the free list.
+    template <class... Args>
+    Handle emplace(Args&&... args) {
+        roomForOne(owner);
+        if (freeHead == NONE) roomForOne(slots);
+        values.emplace_back(forward<Args>(args)...);
+        uint32_t i;
+        if (freeHead != NONE) {
+            i = freeHead;
+            freeHead = slots[i].pos;
+        } else {
+            i = (uint32_t)slots.size();
+            slots.push_back({1, 0});  // capacity reserved above
+        }
+        owner.push_back(i);
+        slots[i].pos = (uint32_t)values.size() - 1;
+        return {(uint64_t)slots[i].gen << 32 | i};
+    }
+    Handle insert(T value) { return emplace(move(value)); }
+
+    bool contains(Handle h) const {
+        return h.index() < slots.size() && slots[h.index()].gen == h.generation();
+    }
+    T* get(Handle h) { return contains(h) ? &values[slots[h.index()].pos] : nullptr; }
+    const T* get(Handle h) const { return contains(h) ? &values[slots[h.index()].pos] : nullptr; }
+
+    // Destroys the value; false if h was already stale.
+    bool erase(Handle h) {
+        if (!contains(h)) return false;
+        Slot& s = slots[h.index()];
+        uint32_t hole = s.pos, last = (uint32_t)values.size() - 1;
+        if (hole != last) {
+            values[hole] = move(values[last]);
+            owner[hole] = owner[last];
+            slots[owner[hole]].pos = hole;
+        }
+        values.pop_back();
+        owner.pop_back();
+        if (++s.gen == 0) s.gen = 1;  // after 2^32 reuses, skip the null generation
+        s.pos = freeHead;
+        freeHead = h.index();
+        return true;
+    }
+
+    void clear() {
+        for (uint32_t i : owner) {
+            if (++slots[i].gen == 0) slots[i].gen = 1;
+            slots[i].pos = freeHead;
+            freeHead = i;
+        }
+        values.clear();
+        owner.clear();
+    }
+
+    size_t size() const { return values.size(); }
+    bool empty() const { return values.empty(); }
+    void reserve(size_t n) { values.reserve(n), owner.reserve(n), slots.reserve(n); }
+
+    // Dense order, which changes on erase.
+    T* begin() { return values.data(); }
+    T* end() { return values.data() + values.size(); }
+    const T* begin() const { return values.data(); }
+    const T* end() const { return values.data() + values.size(); }
+
+private:
+    static constexpr uint32_t NONE = ~0u;
+    // Live slot: pos is the index into values. Free slot: the next free slot.
+    struct Slot { uint32_t gen, pos; };
+
+    vector<T> values;
+    vector<uint32_t> owner;  // owner[k]: slot of values[k]
+    vector<Slot> slots;
+    uint32_t freeHead = NONE;
+
+    // reserve(size() + 1) would grow one element at a time; double instead.
+    template <class V>
+    static void roomForOne(V& v) {
+        if (v.size() == v.capacity()) v.reserve(max<size_t>(16, v.capacity() * 2));
+    }
+};
+
+#ifdef BENCH
+// ==========================================
+// BENCHMARKS - g++ -O2 -DBENCH 18_memory_management.cpp && ./a.out [name ...]
+// ==========================================
+double nowSec() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Resource as it was before the pool: two trips to the global heap.
+class HeapResource {
+    string name;
+    int* data;
+public:
+    HeapResource(string n) : name(move(n)) { data = new int[100]; }
+    ~HeapResource() { delete[] data; }
+    int* payload() { return data; }
+};
+
+// 10^7 create/destroy pairs, back to back and with 4096 objects alive
+// (random one replaced each step), global new vs SlabPool.
+template <class R>
+double churn(size_t N, size_t window) {
+    vector<R*> live(window, nullptr);
+    unsigned x = 1;
+    double t0 = nowSec();
+    for (size_t i = 0; i < N; i++) {
+        x = x * 1103515245 + 12345;
+        R*& slot = live[window > 1 ? (x >> 8) % window : 0];
+        delete slot;
+        slot = new R("r");
+    }
+    for (R* r : live) delete r;
+    return nowSec() - t0;
+}
+
+void benchSlab() {
+    Resource::verbose = false;
+    const size_t N = 10000000;
+    double t0 = nowSec();
+    for (size_t i = 0; i < N; i++) {
+        void* p = ::operator new(400);
+        asm volatile("" : : "r"(p) : "memory");  // keep the pair from being optimized out
+        ::operator delete(p);
+    }
+    double heap = nowSec() - t0;
+    t0 = nowSec();
+    for (size_t i = 0; i < N; i++) {
+        void* p = SlabPool::allocate(400);
+        asm volatile("" : : "r"(p) : "memory");
+        SlabPool::deallocate(p, 400);
+    }
+    double slab = nowSec() - t0;
+    printf("  400-byte block: new/delete %5.1f ns  SlabPool %5.1f ns  (%.1fx)\n", heap / N * 1e9, slab / N * 1e9, heap / slab);
+    for (size_t window : {(size_t)1, (size_t)4096}) {
+        double heap = churn<HeapResource>(N, window), slab = churn<Resource>(N, window);
+        printf("  window %4zu: new/delete %5.1f ns  SlabPool %5.1f ns  (%.1fx)\n", window,
+               heap / N * 1e9, slab / N * 1e9, heap / slab);
+    }
+    // same churn on 4 threads; frees land on the thread that allocated
+    vector<thread> pool;
+    t0 = nowSec();
+    for (int t = 0; t < 4; t++) pool.emplace_back([&] { churn<Resource>(N / 4, 1024); });
+    for (auto& th : pool) th.join();
+    printf("  4 threads:   SlabPool %5.1f ns per pair\n", (nowSec() - t0) / N * 1e9);
+
+    // Producer allocates, consumer frees, batches of 10^4 handed over a
+    // queue at most 4 deep: never more than ~3 MB live, so reserved memory
+    // must stop growing however many blocks pass through.
+    auto reserved = [] {
+        uint64_t r = 0;
+        for (auto& c : SlabPool::stats()) r += c.reserved;
+        return r;
+    };
+    const int BATCH = 10000, ROUNDS = 1000;
+    mutex mu;
+    condition_variable cv;
+    deque<vector<void*>> q;
+    bool done = false;
+    uint64_t before = reserved();
+    t0 = nowSec();
+    thread consumer([&] {
+        for (;;) {
+            unique_lock<mutex> lk(mu);
+            cv.wait(lk, [&] { return !q.empty() || done; });
+            if (q.empty()) return;
+            vector<void*> v = move(q.front());
+            q.pop_front();
+            lk.unlock();
+            cv.notify_all();
+            for (void* p : v) SlabPool::deallocate(p, 64);
+        }
+    });
+    thread producer([&] {
+        for (int r = 0; r < ROUNDS; r++) {
+            vector<void*> v(BATCH);
+            for (void*& p : v) p = SlabPool::allocate(64);
+            unique_lock<mutex> lk(mu);
+            cv.wait(lk, [&] { return q.size() < 4; });
+            q.push_back(move(v));
+            cv.notify_all();
+        }
+        lock_guard<mutex> lk(mu);
+        done = true;
+        cv.notify_all();
+    });
+    producer.join(), consumer.join();
+    printf("  cross-thread: SlabPool %5.1f ns per pair, %.0f MB passed through, reserved +%.1f MB\n",
+           (nowSec() - t0) / ((double)BATCH * ROUNDS) * 1e9, 64.0 * BATCH * ROUNDS / 1e6,
+           (reserved() - before) / 1e6);
+    SlabPool::report();
+}
+
+// The lesson's Node without the messages.
+struct SharedNode {
+    int value;
+    shared_ptr<SharedNode> next;
+    explicit SharedNode(int v) : value(v) {}
+};
+
+// Build / traverse / tear down: shared_ptr chain vs SList in an Arena.
+// 5*10^4 nodes per chain, since a much longer shared_ptr chain overflows
+// the stack when its head is released.
+void benchList() {
+    const int N = 50000, REPS = 200;
+    thread([] {}).join();  // libstdc++ skips the refcount atomics until a thread exists
+    double build = 0, walk = 0, drop = 0;
+    long long sum = 0;
+    for (int r = 0; r < REPS; r++) {
+        double t0 = nowSec();
+        shared_ptr<SharedNode> head;
+        for (int v = 0; v < N; v++) {
+            auto node = make_shared<SharedNode>(v);
+            node->next = move(head);
+            head = move(node);
+        }
+        double t1 = nowSec();
+        for (shared_ptr<SharedNode> cur = head; cur; cur = cur->next) sum += cur->value;  // as in main()
+        double t2 = nowSec();
+        head.reset();
+        double t3 = nowSec();
+        build += t1 - t0, walk += t2 - t1, drop += t3 - t2;
+    }
+    auto ns = [&](double t) { return t / REPS / N * 1e9; };
+    printf("  shared_ptr chain  build %5.2f  walk %5.2f  teardown %5.2f ns/node\n", ns(build), ns(walk), ns(drop));
+    build = walk = drop = 0;
+    Arena arena;
+    for (int r = 0; r < REPS; r++) {
+        double t0 = nowSec();
+        SList<ListNode> list;
+        for (int v = 0; v < N; v++) list.push_front(*arena.make<ListNode>(v));
+        double t1 = nowSec();
+        for (ListNode& node : list) sum -= node.value;
+        double t2 = nowSec();
+        arena.reset();
+        double t3 = nowSec();
+        build += t1 - t0, walk += t2 - t1, drop += t3 - t2;
+    }
+    printf("  SList + Arena     build %5.2f  walk %5.2f  teardown %5.2f ns/node%s\n", ns(build), ns(walk), ns(drop),
+           sum ? "  MISMATCH" : "");
+    double t0 = nowSec();
+    {
+        Arena big;
+        DList<ListNode> list;
+        for (int v = 0; v < 10000000; v++) list.push_back(*big.make<ListNode>(v));
+        for (ListNode& node : list) sum += node.value;
+    }
+    printf("  DList + Arena, one 10^7-node chain: %.2f s total, no recursion\n", nowSec() - t0);
+}
+
+// 2048 x 2048 ints as int** rows / vector<vector<int>> / Matrix: time to
+// allocate + free, and to fill + sum, then a column walk via Matrix::col.
+void benchMatrix() {
+    const int R = 2048, C = 2048, REPS = 20;
+    long long sums[3] = {};
+    double mem[3] = {}, use[3] = {};
+    for (int rep = 0; rep < REPS; rep++) {
+        double t0 = nowSec();
+        int** a = new int*[R];
+        for (int i = 0; i < R; i++) a[i] = new int[C]();
+        double t1 = nowSec();
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++) a[i][j] = i ^ j;
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++) sums[0] += a[i][j];
+        double t2 = nowSec();
+        for (int i = 0; i < R; i++) delete[] a[i];
+        delete[] a;
+        double t3 = nowSec();
+        mem[0] += (t1 - t0) + (t3 - t2), use[0] += t2 - t1;
+
+        t0 = nowSec();
+        auto v = make_unique<vector<vector<int>>>(R, vector<int>(C));
+        t1 = nowSec();
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++) (*v)[i][j] = i ^ j;
+        for (auto& row : *v)
+            for (int x : row) sums[1] += x;
+        t2 = nowSec();
+        v.reset();
+        t3 = nowSec();
+        mem[1] += (t1 - t0) + (t3 - t2), use[1] += t2 - t1;
+
+        t0 = nowSec();
+        auto m = make_unique<Matrix<int>>(R, C);
+        t1 = nowSec();
+        for (int i = 0; i < R; i++)
+            for (int j = 0; j < C; j++) (*m)[i][j] = i ^ j;
+        for (int x : *m) sums[2] += x;
+        t2 = nowSec();
+        m.reset();
+        t3 = nowSec();
+        mem[2] += (t1 - t0) + (t3 - t2), use[2] += t2 - t1;
+    }
+    const char* names[] = {"int** rows", "vector<vector>", "Matrix"};
+    for (int k = 0; k < 3; k++)
+        printf("  %-15s alloc+free %6.2f ms  fill+sum %6.2f ms%s\n", names[k], mem[k] / REPS * 1e3,
+               use[k] / REPS * 1e3, sums[k] == sums[0] ? "" : "  MISMATCH");
+    Matrix<int> m(R, C);
+    for (int i = 0; i < R; i++)
+        for (int j = 0; j < C; j++) m[i][j] = i ^ j;
+    double t0 = nowSec();
+    long long colSum = 0;
+    for (int rep = 0; rep < REPS; rep++)
+        for (int j = 0; j < C; j++)
+            for (int x : m.col(j)) colSum += x;
+    printf("  column-major walk via col(j): %.2f ms%s\n", (nowSec() - t0) / REPS * 1e3,
+           colSum == sums[2] ? "" : "  MISMATCH");
+}
+
+// Allocation-heavy mix: 2*10^7 new[]/delete[] of 8..1024 bytes with 4096
+// blocks alive, plus string and vector churn. Build once plain and once
+// with -DALLOC_PROFILE to see the profiler's cost.
+void benchAlloc() {
+    const int N = 20000000, WINDOW = 4096;
+    vector<char*> live(WINDOW, nullptr);
+    unsigned x = 5;
+    double t0 = nowSec();
+    for (int i = 0; i < N; i++) {
+        x = x * 1103515245 + 12345;
+        char*& slot = live[(x >> 8) % WINDOW];
+        delete[] slot;
+        slot = new char[8 << ((x >> 20) % 8)];
+        slot[0] = (char)i;
+    }
+    for (char* p : live) delete[] p;
+    double raw = nowSec() - t0;
+    t0 = nowSec();
+    size_t total = 0;
+    for (int i = 0; i < N / 20; i++) {
+        vector<string> words;
+        for (int k = 0; k < 10; k++) words.push_back(string(20 + k * 4, 'a'));
+        total += words.size();
+    }
+    double mixed = nowSec() - t0;
+#ifdef ALLOC_PROFILE
+    const char* build = "with ALLOC_PROFILE";
+#else
+    const char* build = "plain";
+#endif
+    printf("  %-18s new/delete %5.2f ns/pair  vector<string> %6.1f ns/round (%zu)\n", build, raw / N * 1e9,
+           mixed / (N / 20) * 1e9, total);
+}
+
+// 2^16 live objects, every 8th one destroyed, then 2*10^7 lookups in random
+// order: weak_ptr::lock() vs SlotMap::get(). Then the same lookups split
+// over 4 threads sharing the objects, and a scan of all live objects.
+struct Entity {
+    long long hp;
+    char rest[56];
+    explicit Entity(long long v = 0) : hp(v) {}
+};
+
+template <class Lookup>
+double lookups(Lookup lookup, int threads, size_t M, long long& sum) {
+    atomic<long long> total{0};
+    vector<thread> pool;
+    double t0 = nowSec();
+    for (int t = 0; t < threads; t++)
+        pool.emplace_back([&, t] {
+            unsigned x = 7 + t;
+            long long s = 0;
+            for (size_t i = 0; i < M / threads; i++) {
+                x = x * 1103515245 + 12345;
+                s += lookup(x >> 8);
+            }
+            total += s;
+        });
+    for (auto& th : pool) th.join();
+    sum = total;
+    return (nowSec() - t0) / M * 1e9;
+}
+
+void benchSlotMap() {
+    const uint32_t N = 1 << 16;
+    const size_t M = 20000000;
+    thread([] {}).join();  // libstdc++ skips the refcount atomics until a thread exists
+
+    vector<shared_ptr<Entity>> owners;
+    vector<weak_ptr<Entity>> weak;
+    SlotMap<Entity> map;
+    vector<SlotMap<Entity>::Handle> handles;
+    map.reserve(N);
+    for (uint32_t i = 0; i < N; i++) {
+        owners.push_back(make_shared<Entity>(i));
+        weak.push_back(owners.back());
+        handles.push_back(map.emplace(i));
+    }
+    for (uint32_t i = 0; i < N; i += 8) {
+        owners[i].reset();
+        map.erase(handles[i]);
+    }
+
+    auto viaWeak = [&](uint32_t k) -> long long {
+        if (auto p = weak[k % N].lock()) return p->hp;
+        return 0;
+    };
+    auto viaSlot = [&](uint32_t k) -> long long {
+        if (Entity* e = map.get(handles[k % N])) return e->hp;
+        return 0;
+    };
+    for (int threads : {1, 4}) {
+        long long a, b;
+        double w = lookups(viaWeak, threads, M, a), s = lookups(viaSlot, threads, M, b);
+        printf("  %d thread%s  weak_ptr::lock %5.2f ns  SlotMap::get %5.2f ns  (%.1fx)%s\n", threads,
+               threads > 1 ? "s" : " ", w, s, w / s, a == b ? "" : "  MISMATCH");
+    }
+
+    long long a = 0, b = 0;
+    double t0 = nowSec();
+    for (int rep = 0; rep < 100; rep++)
+        for (auto& p : owners)
+            if (p) a += p->hp;
+    double t1 = nowSec();
+    for (int rep = 0; rep < 100; rep++)
+        for (Entity& e : map) b += e.hp;
+    double t2 = nowSec();
+    printf("  scan all live: vector<shared_ptr> %5.2f ns  SlotMap %5.2f ns per object%s\n",
+           (t1 - t0) / 100 / map.size() * 1e9, (t2 - t1) / 100 / map.size() * 1e9, a == b ? "" : "  MISMATCH");
+}
+
+int runBenchmarks(int argc, char** argv) {
+    struct Case { const char* name; void (*run)(); };
+    static const Case cases[] = {
+        {"slab", benchSlab},
+        {"list", benchList},
+        {"matrix", benchMatrix},
+        {"alloc", benchAlloc},
+        {"slotmap", benchSlotMap},
+    };
+    for (const Case& c : cases) {
+        bool pick = argc < 2;
+        for (int i = 1; i < argc; i++) if (!strcmp(argv[i], c.name)) pick = true;
+        if (!pick) continue;
+        printf("[%s]\n", c.name);
+        c.run();
+        fflush(stdout);
+    }
+    return 0;
+}
+#endif
+
+int main(int argc, char** argv) {
+#ifdef BENCH
+    return runBenchmarks(argc, argv);
+#endif
+    (void)argc, (void)argv;
     // ==========================================
     // STACK VS HEAP MEMORY
     // ==========================================
@@ -118,13 +1414,13 @@ int main() {
     arr = nullptr; // Good practice: set to null after delete
     
     // 2D array on heap
+    // The classic way is int** matrix = new int*[rows] plus one
+    // new int[cols] per row: rows end up scattered across the heap and
+    // need a delete[] loop. Matrix keeps all of it in one aligned block.
     int rows = 3, cols = 4;
-    int** matrix = new int*[rows];
-    for (int i = 0; i < rows; i++) {
-        matrix[i] = new int[cols];
-    }
+    Matrix<int> matrix(rows, cols);
     
-    // Use it
+    // Use it - matrix[i][j] works as before
     for (int i = 0; i < rows; i++) {
         for (int j = 0; j < cols; j++) {
             matrix[i][j] = i * cols + j;
@@ -139,11 +1435,16 @@ int main() {
         cout << endl;
     }
     
-    // Delete 2D array (reverse order!)
-    for (int i = 0; i < rows; i++) {
-        delete[] matrix[i];
-    }
-    delete[] matrix;
+    // Views share the storage: a column, every other column of rows 1-2
+    cout << "Column 1: ";
+    for (int x : matrix.col(1)) cout << x << " ";
+    cout << endl;
+    MatrixView<int> block = matrix.sub(1, 0, 2, 2, 1, 2);
+    cout << "Rows 1-2, columns 0 and 2: " << block(0, 0) << " " << block(0, 1) << " / "
+         << block(1, 0) << " " << block(1, 1) << endl;
+    
+    Matrix<int> moved = move(matrix);  // Ownership moves, nothing is copied
+    // No delete loop: the single block is freed when `moved` goes away
     
     // ==========================================
     // OBJECTS ON HEAP
@@ -154,6 +1455,12 @@ int main() {
     res->use();
     delete res;  // Destructor called here
     
+    // Resource overrides operator new, so that `new` came from SlabPool.
+    // Any container can use the pool through SlabAllocator.
+    vector<int, SlabAllocator<int>> pooled(50, 7);
+    cout << "Pooled vector size: " << pooled.size() << endl;
+    SlabPool::report();
+    
     // ==========================================
     // SMART POINTERS (C++11) - RECOMMENDED!
     // ==========================================
@@ -236,6 +1543,30 @@ int main() {
         
     }  // All nodes automatically destroyed
     
+    // Every step above copies a shared_ptr (two atomic ops), and freeing
+    // the head frees the chain recursively - ~10^5 nodes overflow the stack.
+    // Intrusive lists in an Arena have neither cost.
+    cout << "\n--- Intrusive lists in an Arena ---" << endl;
+    {
+        Arena arena;
+        SList<ListNode> slist;
+        DList<ListNode> dlist;
+        for (int v = 1; v <= 5; v++) {
+            ListNode* node = arena.make<ListNode>(v);
+            slist.push_front(*node);  // same node, two lists
+            dlist.push_back(*node);
+        }
+        slist.reverse();
+        cout << "Singly linked: ";
+        for (ListNode& node : slist) cout << node.value << " ";
+        cout << endl;
+        
+        dlist.erase(dlist.front());  // O(1), nothing freed
+        cout << "Doubly linked, backwards: ";
+        for (auto it = dlist.end(); it != dlist.begin();) cout << (--it)->value << " ";
+        cout << endl;
+    }  // The arena frees every node at once
+    
     // ================
     // weak_ptr - Non-owning reference (breaks cycles)
     // ================
@@ -257,6 +1588,17 @@ int main() {
     
     cout << "Outside scope - expired: " << wptr.expired() << endl;
     
+    // The same check without a control block: a SlotMap handle carries a
+    // generation, and erase() makes every older handle fail get().
+    cout << "\n--- SlotMap handles ---" << endl;
+    SlotMap<string> names;
+    auto h = names.insert("WeakTest");
+    if (string* s = names.get(h)) cout << "Handle valid: " << *s << endl;
+    names.erase(h);
+    auto h2 = names.insert("Reused");  // same slot, next generation
+    cout << "Old handle valid: " << names.contains(h) << ", new slot " << h2.index()
+         << " generation " << h2.generation() << ": " << *names.get(h2) << endl;
+    
     // ==========================================
     // MEMORY LEAK PREVENTION TIPS
     // ==========================================
@@ -267,7 +1609,8 @@ int main() {
      * 2. Use smart pointers when possible
      * 3. Set pointers to nullptr after delete
      * 4. Use RAII (Resource Acquisition Is Initialization)
-     * 5. Use valgrind to detect leaks
+     * 5. Use valgrind to detect leaks (or build with -DALLOC_PROFILE for
+     *    a cheap always-on report: counts, live bytes, hot call sites)
      * 6. Prefer stack allocation when possible
      * 7. Use containers (vector, etc.) instead of raw arrays
      */
@@ -312,11 +1655,33 @@ int main() {
  *   w.expired()              // Check if valid
  *   w.lock()                 // Get shared_ptr
  * 
+ * SlotMap<T> - Generation-checked handles, no refcount
+ *   auto h = map.insert(value);  // 64-bit index + generation
+ *   map.get(h)               // T* or nullptr once erased
+ *   map.erase(h)             // Old handles stop matching
+ *   for (T& x : map)         // Values stored densely
+ * 
+ * 2D ARRAYS:
+ * Matrix<int> m(rows, cols);  // One aligned block, m[i][j]
+ * m.row(i), m.col(j), m.sub(r0, c0, nr, nc)  // Views, no copy
+ * 
+ * ARENA + INTRUSIVE LISTS:
+ * Arena a; T* p = a.make<T>(args);   // Freed together
+ * struct N : SLink<>, DLink<> {...}  // Links live in the node
+ * SList<N> / DList<N> - push_front, erase, ... (never own)
+ * 
+ * POOLS:
+ * SlabPool::allocate(bytes) / deallocate(p, bytes)
+ * vector<T, SlabAllocator<T>> - container on the pool
+ * static void* operator new(size_t) - per-class allocation
+ * SlabPool::report()           // Hit rate, fragmentation
+ * 
  * TIPS:
  * - Prefer smart pointers over raw
  * - Use unique_ptr by default
  * - Use shared_ptr when sharing is needed
  * - Use weak_ptr to break cycles
+ * - Use SlotMap handles when one container owns the objects
  * - Use vector instead of dynamic arrays
  * 
  * COMMON MISTAKES:
@@ -7,9 +7,1403 @@
 #include <string>
 #include <vector>
 #include <sstream>
+#include <string_view>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <climits>
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <array>
+#include <utility>
+#include <cerrno>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+#include <fcntl.h>      // open, posix_fadvise, splice
+#include <sys/mman.h>   // mmap, madvise
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>  // SSE2 newline scan
+#endif
 using namespace std;
 
-int main() {
+// ==========================================
+// MAPPED FILES - read lines without copying
+// ==========================================
+// First '\n' in [p, end), or end. 16 bytes per compare with SSE2.
+inline const char* findNewline(const char* p, const char* end) {
+#if defined(__SSE2__)
+    const __m128i nl = _mm_set1_epi8('\n');
+    for (; end - p >= 16; p += 16) {
+        int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)p), nl));
+        if (mask) return p + __builtin_ctz(mask);
+    }
+#endif
+    const void* hit = memchr(p, '\n', end - p);
+    return hit ? (const char*)hit : end;
+}
+
+// Maps a file one window at a time and hands out lines as string_views into
+// the mapping. Windows slide forward as lines are consumed, so files larger
+// than RAM work; a line longer than the window grows the window.
+class MappedFile {
+public:
+    static const size_t DEFAULT_WINDOW = 256 << 20;
+
+    explicit MappedFile(const string& path, size_t window = DEFAULT_WINDOW) : window(window) {
+        fd = open(path.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd >= 0 && fstat(fd, &st) == 0) fileSize = st.st_size;
+    }
+    ~MappedFile() {
+        if (map) munmap(map, mapLen);
+        if (fd >= 0) close(fd);
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool ok() const { return fd >= 0; }
+    size_t size() const { return fileSize; }
+
+    // Next line without its '\n' (same lines getline would give). The view
+    // stays valid until the window slides - copy it if you keep it.
+    bool nextLine(string_view& line) {
+        if (fd < 0 || pos >= fileSize) return false;
+        for (;;) {
+            if (!map || pos >= mapOff + mapLen) slide(pos);
+            const char* b = map + (pos - mapOff);
+            const char* e = map + mapLen;
+            const char* nl = findNewline(b, e);
+            if (nl != e || mapOff + mapLen == fileSize) {
+                line = string_view(b, nl - b);
+                pos += (nl - b) + (nl != e);
+                return true;
+            }
+            if (mapOff == pageStart(pos)) window *= 2;  // the line alone fills the window
+            slide(pos);
+        }
+    }
+
+private:
+    int fd = -1;
+    size_t fileSize = 0, window;
+    char* map = nullptr;
+    size_t mapOff = 0, mapLen = 0, pos = 0;
+
+    static size_t pageStart(size_t off) { return off & ~(size_t)(sysconf(_SC_PAGESIZE) - 1); }
+
+    void slide(size_t from) {
+        if (map) munmap(map, mapLen);
+        mapOff = pageStart(from);
+        mapLen = min(window, fileSize - mapOff);
+        void* m = mmap(nullptr, mapLen, PROT_READ, MAP_PRIVATE, fd, mapOff);
+        if (m == MAP_FAILED) throw runtime_error("mmap failed");
+        map = (char*)m;
+        madvise(map, mapLen, MADV_SEQUENTIAL);
+    }
+};
+
+// for (string_view line : LineView(file)) { ... }
+struct LineView {
+    MappedFile& file;
+    explicit LineView(MappedFile& f) : file(f) {}
+
+    struct End {};
+    struct iterator {
+        MappedFile* f;
+        string_view cur;
+        bool done = false;
+        string_view operator*() const { return cur; }
+        iterator& operator++() { done = !f->nextLine(cur); return *this; }
+        bool operator!=(End) const { return !done; }
+    };
+    iterator begin() { iterator it{&file, {}, false}; return ++it; }
+    End end() { return {}; }
+};
+
+// ==========================================
+// BINARY INTEGER FILES - load with one mmap
+// ==========================================
+// Whole-file read-only mapping (RAII). Empty or missing files give size 0.
+struct Mapping {
+    char* data = nullptr;
+    size_t size = 0;
+
+    explicit Mapping(const string& path, bool writable = false) {
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat st;
+        if (fd < 0) return;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            // MAP_PRIVATE + PROT_WRITE is copy-on-write: edits never reach the file
+            int prot = PROT_READ | (writable ? PROT_WRITE : 0);
+            void* m = mmap(nullptr, st.st_size, prot, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) data = (char*)m, size = st.st_size;
+        }
+        close(fd);
+    }
+    ~Mapping() { if (data) munmap(data, size); }
+    Mapping(Mapping&& o) noexcept : data(o.data), size(o.size) { o.data = nullptr, o.size = 0; }
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+};
+
+#if __cplusplus >= 202002L
+template <class T> using Span = std::span<T>;
+#else
+template <class T>
+struct Span {  // the part of std::span we need, for C++17 builds
+    T* ptr = nullptr;
+    size_t n = 0;
+    Span() {}
+    Span(T* p, size_t len) : ptr(p), n(len) {}
+    T* data() const { return ptr; }
+    size_t size() const { return n; }
+    bool empty() const { return n == 0; }
+    T& operator[](size_t i) const { return ptr[i]; }
+    T* begin() const { return ptr; }
+    T* end() const { return ptr + n; }
+};
+#endif
+
+// File layout (all little-endian):
+//   ColFileHeader                    16 bytes
+//   ColumnDesc x columns             32 bytes each
+//   column data, each starting on a 64-byte boundary
+// A column's checksum covers its count * elemSize data bytes.
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "column files are stored little-endian");
+
+enum class ColType : uint32_t { I32 = 1, I64 = 2, U32 = 3, U64 = 4, F32 = 5, F64 = 6 };
+template <class T>
+constexpr ColType colType() {
+    static_assert(is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8), "4- or 8-byte numbers only");
+    if constexpr (is_floating_point_v<T>) return sizeof(T) == 4 ? ColType::F32 : ColType::F64;
+    else if constexpr (is_signed_v<T>) return sizeof(T) == 4 ? ColType::I32 : ColType::I64;
+    else return sizeof(T) == 4 ? ColType::U32 : ColType::U64;
+}
+
+struct ColFileHeader {
+    char magic[8];      // "CPLSCOL\0"
+    uint32_t version;   // 1
+    uint32_t columns;
+};
+struct ColumnDesc {
+    uint64_t count;
+    uint64_t offset;    // from start of file, multiple of 64
+    ColType type;
+    uint32_t elemSize;
+    uint64_t checksum;
+};
+static_assert(sizeof(ColFileHeader) == 16 && sizeof(ColumnDesc) == 32, "on-disk layout");
+const char COL_MAGIC[8] = {'C', 'P', 'L', 'S', 'C', 'O', 'L', 0};
+
+// 4-lane multiply-rotate hash over 8-byte words (xxHash64-style rounds).
+// Fast enough that verifying costs about one pass over memory.
+inline uint64_t colChecksum(const char* p, size_t n) {
+    const uint64_t P1 = 0x9E3779B185EBCA87ULL, P2 = 0xC2B2AE3D27D4EB4FULL;
+    auto round = [&](uint64_t h, uint64_t w) {
+        h += w * P2;
+        return ((h << 31) | (h >> 33)) * P1;
+    };
+    uint64_t h[4] = {P1 + P2, P2, 0, 0 - P1};
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+        for (int k = 0; k < 4; k++) {
+            uint64_t w;
+            memcpy(&w, p + i + 8 * k, 8);
+            h[k] = round(h[k], w);
+        }
+    uint64_t r = n;
+    for (int k = 0; k < 4; k++) r = round(r, h[k]);
+    for (; i < n; i++) r = round(r, (unsigned char)p[i]);
+    return r ^ (r >> 29);
+}
+
+// Collects columns in memory, then writes the whole file in one go.
+class ColumnWriter {
+public:
+    template <class T>
+    void add(const T* data, size_t n) {
+        descs.push_back({n, 0, colType<T>(), sizeof(T), colChecksum((const char*)data, n * sizeof(T))});
+        blobs.emplace_back((const char*)data, n * sizeof(T));
+    }
+    template <class T>
+    void add(const vector<T>& v) { add(v.data(), v.size()); }
+
+    bool save(const string& path) {
+        uint64_t off = align64(sizeof(ColFileHeader) + descs.size() * sizeof(ColumnDesc));
+        for (ColumnDesc& d : descs) d.offset = off, off = align64(off + d.count * d.elemSize);
+        ColFileHeader h{};
+        memcpy(h.magic, COL_MAGIC, 8);
+        h.version = 1;
+        h.columns = descs.size();
+        ofstream out(path, ios::binary);
+        out.write((const char*)&h, sizeof h);
+        out.write((const char*)descs.data(), descs.size() * sizeof(ColumnDesc));
+        for (size_t i = 0; i < descs.size(); i++) {
+            pad(out, descs[i].offset);
+            out.write(blobs[i].data(), blobs[i].size());
+        }
+        pad(out, off);
+        return (bool)out;
+    }
+
+private:
+    vector<ColumnDesc> descs;
+    vector<string_view> blobs;  // caller keeps the data alive until save()
+
+    static uint64_t align64(uint64_t x) { return (x + 63) & ~63ULL; }
+    static void pad(ofstream& out, uint64_t to) {
+        static const char zeros[64] = {};
+        uint64_t at = out.tellp();
+        out.write(zeros, to - at);
+    }
+};
+
+// Maps a column file and hands out columns as spans into the mapping - no
+// copy, no parse. Spans are writable copy-on-write views; they live as long
+// as the ColumnFile. Throws runtime_error on a malformed file.
+class ColumnFile {
+public:
+    explicit ColumnFile(const string& path) : m(path, true) {
+        if (m.size < sizeof(ColFileHeader)) throw runtime_error(path + ": not a column file");
+        memcpy(&h, m.data, sizeof h);
+        if (memcmp(h.magic, COL_MAGIC, 8) != 0 || h.version != 1) throw runtime_error(path + ": bad header");
+        if (sizeof h + (uint64_t)h.columns * sizeof(ColumnDesc) > m.size) throw runtime_error(path + ": truncated");
+        for (uint32_t i = 0; i < h.columns; i++) {
+            const ColumnDesc& d = desc(i);
+            if (d.elemSize == 0 || d.offset % 64) throw runtime_error(path + ": bad column");
+            if (d.offset > m.size || d.count > (m.size - d.offset) / d.elemSize) throw runtime_error(path + ": truncated");
+        }
+    }
+
+    size_t columns() const { return h.columns; }
+    const ColumnDesc& desc(size_t i) const {
+        return ((const ColumnDesc*)(m.data + sizeof(ColFileHeader)))[i];
+    }
+    bool verify(size_t i) const {
+        const ColumnDesc& d = desc(i);
+        return colChecksum(m.data + d.offset, d.count * d.elemSize) == d.checksum;
+    }
+
+    template <class T>
+    Span<T> column(size_t i, bool check = false) const {
+        if (i >= h.columns || desc(i).type != colType<T>() || desc(i).elemSize != sizeof(T))
+            throw runtime_error("column type mismatch");
+        if (check && !verify(i)) throw runtime_error("column checksum mismatch");
+        return Span<T>((T*)(m.data + desc(i).offset), desc(i).count);
+    }
+
+private:
+    Mapping m;
+    ColFileHeader h;
+};
+
+// ==========================================
+// ASYNC WRITER - format into one buffer, a thread writes the other
+// ==========================================
+// Drop-in for `ofstream out(path); out << x << '\n';` on big outputs.
+// operator<< only copies into the front buffer; when it fills, the buffers
+// swap and a background thread write()s the full one while formatting goes
+// on. Nothing is flushed per line.
+//   flush() - hand over what is buffered and wait until the kernel has it
+//   close() - flush, stop the thread, close the file
+// Both return false once any write has failed; error() says why. After a
+// failure further output is dropped. The destructor closes but cannot
+// report - call close() yourself if the result matters.
+class AsyncWriter {
+public:
+    static constexpr size_t MIN_BUF = 4096;  // integers are formatted in place and need 24 free bytes
+    explicit AsyncWriter(const string& path, bool append = false, size_t bufBytes = 4 << 20)
+        : cap(max(bufBytes, MIN_BUF)) {
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | (append ? O_APPEND : O_TRUNC), 0644);
+        if (fd < 0) { fail(path); return; }
+        bufs[0].reset(new char[cap]);
+        bufs[1].reset(new char[cap]);
+        worker = thread([this] { run(); });
+    }
+    ~AsyncWriter() { close(); }
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+
+    void write(const char* p, size_t n) {
+        while (n && fd >= 0) {
+            size_t k = min(n, cap - used);
+            memcpy(bufs[front].get() + used, p, k);
+            used += k, p += k, n -= k;
+            if (used == cap) handOver();
+        }
+    }
+    AsyncWriter& operator<<(string_view s) { write(s.data(), s.size()); return *this; }
+    AsyncWriter& operator<<(const char* s) { return *this << string_view(s); }
+    AsyncWriter& operator<<(char c) {
+        if (fd < 0) return *this;
+        bufs[front][used++] = c;
+        if (used == cap) handOver();
+        return *this;
+    }
+    AsyncWriter& operator<<(signed char c) { return *this << (char)c; }  // bytes, like ostream
+    AsyncWriter& operator<<(unsigned char c) { return *this << (char)c; }
+    AsyncWriter& operator<<(bool b) { return *this << (b ? '1' : '0'); }
+    template <class T, enable_if_t<is_integral_v<T> && (sizeof(T) > 1), int> = 0>
+    AsyncWriter& operator<<(T v) {
+        if (fd < 0) return *this;
+        if (cap - used < 24) handOver();
+        char* p = bufs[front].get() + used;
+        make_unsigned_t<T> u = v;
+        if constexpr (is_signed_v<T>) if (v < 0) *p++ = '-', u = 0 - u;
+        char tmp[24];
+        int k = 0;
+        do tmp[k++] = '0' + u % 10, u /= 10; while (u);
+        while (k) *p++ = tmp[--k];
+        used = p - bufs[front].get();
+        return *this;
+    }
+    AsyncWriter& operator<<(double v) {  // same digits as ofstream's default
+        char tmp[32];
+        return *this << string_view(tmp, snprintf(tmp, sizeof tmp, "%g", v));
+    }
+
+    bool flush() {
+        if (fd < 0) return false;
+        handOver();
+        unique_lock<mutex> lk(mu);
+        done.wait(lk, [&] { return !pending; });
+        return err.empty();
+    }
+    bool close() {
+        if (fd < 0) return err.empty();
+        bool good = flush();
+        {
+            lock_guard<mutex> lk(mu);
+            stop = true;
+        }
+        ready.notify_one();
+        worker.join();
+        if (::close(fd) != 0 && good) fail("close"), good = false;
+        fd = -1;
+        return good;
+    }
+    bool ok() const { lock_guard<mutex> lk(mu); return err.empty(); }
+    explicit operator bool() const { return ok(); }
+    string error() const { lock_guard<mutex> lk(mu); return err; }
+
+private:
+    int fd = -1;
+    size_t cap, used = 0;
+    unique_ptr<char[]> bufs[2];
+    int front = 0;
+    thread worker;
+    mutable mutex mu;
+    condition_variable ready, done;
+    bool pending = false, stop = false;  // pending: bufs[front ^ 1] holds `pendingLen` bytes
+    size_t pendingLen = 0;
+    string err;
+
+    void fail(const string& what) { err = what + ": " + strerror(errno); }
+
+    // Waits for the writer to finish the back buffer, then gives it ours.
+    void handOver() {
+        if (!used) return;
+        unique_lock<mutex> lk(mu);
+        done.wait(lk, [&] { return !pending; });
+        if (!err.empty()) { used = 0; return; }
+        pending = true, pendingLen = used;
+        front ^= 1, used = 0;
+        lk.unlock();
+        ready.notify_one();
+    }
+
+    void run() {
+        unique_lock<mutex> lk(mu);
+        for (;;) {
+            ready.wait(lk, [&] { return pending || stop; });
+            if (!pending) return;
+            const char* p = bufs[front ^ 1].get();
+            size_t n = pendingLen;
+            lk.unlock();
+            string what;
+            while (n) {
+                ssize_t w = ::write(fd, p, n);
+                if (w < 0 && errno == EINTR) continue;
+                if (w <= 0) { what = w < 0 ? string("write: ") + strerror(errno) : "write: no progress"; break; }
+                p += w, n -= w;
+            }
+            lk.lock();
+            if (!what.empty() && err.empty()) err = what;
+            pending = false;
+            done.notify_one();
+        }
+    }
+};
+
+// ==========================================
+// SENDING A FILE OUT - let the kernel copy it
+// ==========================================
+// `while (getline(in, line)) cout << line << endl;` copies every byte into
+// user space twice and makes a syscall per line. When a file is only being
+// passed on, these calls move it inside the kernel instead:
+//   copy_file_range - file -> file (may even share extents)
+//   sendfile        - file -> anything that accepts splice (pipes, sockets, files)
+//   splice          - file -> pipe
+// Each is tried in that order and skipped when the kernel or the
+// descriptors don't support it; a 1 MB read/write loop is the last resort.
+enum class CopyVia { CopyFileRange, Sendfile, Splice, ReadWrite };
+
+// Pipes, sockets and /proc files report no usable size: copy from the
+// current position until EOF, by splice() (one end must be a pipe) or else
+// read/write.
+inline long long copyStream(int in, int out, CopyVia first, CopyVia* used) {
+    long long total = 0;
+    ssize_t n = -1;
+    if (first <= CopyVia::Splice) {
+        if (used) *used = CopyVia::Splice;
+        while ((n = splice(in, nullptr, out, nullptr, 1 << 20, SPLICE_F_MOVE)) != 0) {
+            if (n > 0) total += n;
+            else if (errno == EINTR) continue;
+            else if (errno == EINVAL && total == 0) break;  // no pipe on either end
+            else return -1;
+        }
+        if (n == 0) return total;
+    }
+    if (used) *used = CopyVia::ReadWrite;
+    unique_ptr<char[]> buf(new char[1 << 20]);
+    while ((n = read(in, buf.get(), 1 << 20)) != 0) {
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) return -1;
+        for (ssize_t done = 0; done < n;) {
+            ssize_t w = write(out, buf.get() + done, n - done);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) return -1;
+            done += w;
+        }
+        total += n;
+    }
+    return total;
+}
+
+// Copies `in` from its start to `out`'s current position, starting the cascade
+// at `first` (benchmarks force a path this way). Returns bytes copied or -1;
+// `used` gets the path that moved the data. Inputs without a size (see
+// copyStream) are copied from their current position to EOF.
+inline long long copyFd(int in, int out, CopyVia first = CopyVia::CopyFileRange, CopyVia* used = nullptr) {
+    struct stat st;
+    if (fstat(in, &st) != 0) return -1;
+    if (!S_ISREG(st.st_mode) || st.st_size == 0) return copyStream(in, out, first, used);
+    off_t off = 0, size = st.st_size;
+    auto unsupported = [] { return errno == EINVAL || errno == ENOSYS || errno == EXDEV || errno == EOPNOTSUPP || errno == EBADF; };
+    for (int via = (int)first; off < size; via++) {
+        if (used) *used = (CopyVia)via;
+        ssize_t n = 0;
+        switch ((CopyVia)via) {
+        case CopyVia::CopyFileRange:
+            while (off < size && (n = copy_file_range(in, &off, out, nullptr, size - off, 0)) > 0) {}
+            break;
+        case CopyVia::Sendfile:
+            while (off < size && (n = sendfile(out, in, &off, min<off_t>(size - off, 1 << 30))) > 0) {}
+            break;
+        case CopyVia::Splice:
+            while (off < size && (n = splice(in, &off, out, nullptr, size - off, SPLICE_F_MOVE)) > 0) {}
+            break;
+        case CopyVia::ReadWrite: {
+            unique_ptr<char[]> buf(new char[1 << 20]);
+            while (off < size && (n = pread(in, buf.get(), min<off_t>(size - off, 1 << 20), off)) > 0) {
+                for (ssize_t done = 0; done < n;) {
+                    ssize_t w = write(out, buf.get() + done, n - done);
+                    if (w < 0 && errno == EINTR) continue;
+                    if (w <= 0) return -1;
+                    done += w;
+                }
+                off += n;
+            }
+            if (n < 0 && errno == EINTR) { via--; continue; }
+            return n < 0 ? -1 : off;
+        }
+        }
+        if (off >= size || n == 0) break;  // done, or the file shrank under us
+        if (errno == EINTR) via--;
+        else if (!unsupported()) return -1;
+    }
+    return off;
+}
+
+// Streams a whole file to a descriptor (stdout by default).
+inline bool catFile(const string& path, int out = STDOUT_FILENO) {
+    int in = open(path.c_str(), O_RDONLY);
+    if (in < 0) return false;
+    if (out == STDOUT_FILENO) cout.flush();  // keep order with earlier cout output
+    long long n = copyFd(in, out);
+    close(in);
+    return n >= 0;
+}
+
+// ==========================================
+// DURABLE APPEND LOG - group commit, CRC-checked records
+// ==========================================
+// CRC-32C (Castagnoli), table-driven.
+inline uint32_t crc32c(const char* p, size_t n, uint32_t crc = 0) {
+    static const auto table = [] {
+        array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = c & 1 ? (c >> 1) ^ 0x82F63B78 : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    crc = ~crc;
+    for (size_t i = 0; i < n; i++) crc = table[(crc ^ (unsigned char)p[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// What `ofstream log(path, ios::app)` should be when records must survive a
+// crash. Each record is [u32 length][u32 crc][payload]; the crc covers the
+// length too, so zero-filled garbage never looks like a record.
+//
+// append() returns once the record is on disk. Concurrent appenders are
+// batched: whoever finds no sync running becomes the leader, writes every
+// record queued so far with one write() and one fdatasync(), and wakes the
+// rest. One slow sync therefore covers a whole burst of appends.
+//
+// Opening scans the file and truncates anything after the last intact
+// record (a write torn by a crash). A log it creates is only durable once
+// its directory entry is, so the parent directory is fsynced before the
+// first append. After a failed open, write or sync the log refuses
+// further appends; error() says why.
+class DurableLog {
+public:
+    static constexpr uint32_t MAX_RECORD = 1 << 30;
+
+    explicit DurableLog(const string& path) {
+        size_t good = 0;
+        {
+            Mapping m(path);
+            good = scan(m.data, m.size, [&](string_view) { recovered++; });
+            torn = m.size - good;
+        }
+        fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_APPEND, 0644);
+        bool created = fd >= 0;
+        if (!created && errno == EEXIST) fd = open(path.c_str(), O_WRONLY | O_APPEND);
+        if (fd < 0) { fail(path); return; }
+        if (created && !syncParentDir(path)) { fail("fsync directory of " + path); return; }
+        if (torn && (ftruncate(fd, good) != 0 || fdatasync(fd) != 0)) fail(path);
+    }
+    ~DurableLog() { if (fd >= 0) close(fd); }
+    DurableLog(const DurableLog&) = delete;
+    DurableLog& operator=(const DurableLog&) = delete;
+
+    bool append(string_view rec) {
+        if (rec.size() > MAX_RECORD) return false;
+        unique_lock<mutex> lk(mu);
+        if (!err.empty()) return false;
+        char head[8];
+        uint32_t len = rec.size();
+        memcpy(head, &len, 4);
+        uint32_t crc = crc32c(rec.data(), rec.size(), crc32c(head, 4));
+        memcpy(head + 4, &crc, 4);
+        queue.append(head, 8).append(rec.data(), rec.size());
+        uint64_t mine = ++queued;
+        while (synced < mine && err.empty()) {
+            if (syncing) { wake.wait(lk); continue; }
+            syncing = true;
+            string batch;
+            batch.swap(queue);
+            uint64_t upTo = queued;
+            lk.unlock();
+            string what = writeAndSync(batch);
+            lk.lock();
+            if (!what.empty()) err = what;
+            else synced = upTo, syncs++;
+            syncing = false;
+            wake.notify_all();
+        }
+        return err.empty();
+    }
+
+    size_t recoveredRecords() const { return recovered; }  // intact records found on open
+    size_t tornBytes() const { return torn; }              // bytes cut off on open
+    uint64_t syncCount() const { lock_guard<mutex> lk(mu); return syncs; }
+    string error() const { lock_guard<mutex> lk(mu); return err; }
+
+    // Calls f(string_view) for each intact record of a log file, in order.
+    template <class F>
+    static size_t replay(const string& path, F f) {
+        Mapping m(path);
+        size_t n = 0;
+        scan(m.data, m.size, [&](string_view r) { f(r), n++; });
+        return n;
+    }
+
+private:
+    int fd = -1;
+    size_t recovered = 0, torn = 0;
+    mutable mutex mu;
+    condition_variable wake;
+    string queue, err;                   // queue: encoded records not yet written
+    uint64_t queued = 0, synced = 0, syncs = 0;
+    bool syncing = false;
+
+    void fail(const string& what) { err = what + ": " + strerror(errno); }
+
+    // Makes a new file's directory entry durable.
+    static bool syncParentDir(const string& path) {
+        size_t slash = path.rfind('/');
+        string dir = slash == string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int d = open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+        if (d < 0) return false;
+        int r;
+        do r = fsync(d); while (r != 0 && errno == EINTR);
+        int saved = errno;
+        close(d);
+        errno = saved;
+        return r == 0;
+    }
+
+    string writeAndSync(const string& batch) {
+        const char* p = batch.data();
+        size_t n = batch.size();
+        while (n) {
+            ssize_t w = write(fd, p, n);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) return w < 0 ? string("write: ") + strerror(errno) : "write: no progress";
+            p += w, n -= w;
+        }
+        if (fdatasync(fd) != 0) return string("fdatasync: ") + strerror(errno);
+        return "";
+    }
+
+    // Walks records from the start; returns the length of the intact prefix.
+    template <class F>
+    static size_t scan(const char* p, size_t size, F f) {
+        size_t at = 0;
+        while (size - at >= 8) {
+            uint32_t len, crc;
+            memcpy(&len, p + at, 4);
+            memcpy(&crc, p + at + 4, 4);
+            if (len > MAX_RECORD || len > size - at - 8) break;
+            if (crc32c(p + at + 8, len, crc32c(p + at, 4)) != crc) break;
+            f(string_view(p + at + 8, len));
+            at += 8 + len;
+        }
+        return at;
+    }
+};
+
+// ==========================================
+// INTEGER TEXT PARSING - SWAR, chunked across cores
+// ==========================================
+// 8 digit bytes ('0' already subtracted, first digit lowest) to their value.
+inline uint64_t swar8(uint64_t d) {
+    d = (d * 10 + (d >> 8)) & 0x00FF00FF00FF00FFULL;
+    d = (d * 100 + (d >> 16)) & 0x0000FFFF0000FFFFULL;
+    return (d * 10000 + (d >> 32)) & 0xFFFFFFFFULL;
+}
+
+// Parses every integer in [p, end) into out (whitespace-separated text).
+// Digits are converted 8 at a time while at least 8 bytes remain.
+// A token that isn't an int - no digits ("abc", a lone "-"), trailing
+// junk ("12abc") or outside int range - is skipped, not stored.
+// Returns how many tokens were skipped.
+inline size_t parseInts(const char* p, const char* end, vector<int>& out) {
+    static const uint64_t POW10[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+    size_t skipped = 0;
+    while (p < end) {
+        while (p < end && (unsigned char)*p <= ' ') p++;
+        if (p == end) break;
+        bool neg = *p == '-';
+        if (neg || *p == '+') p++;
+        const char* first = p;
+        while (p < end && *p == '0') p++;  // so the digit count below is the significant one
+        const char* sig = p;
+        uint64_t x = 0;
+        for (;;) {
+            if (end - p >= 8) {
+                uint64_t c, d, bad;
+                memcpy(&c, p, 8);
+                d = c - 0x3030303030303030ULL;
+                bad = (d | (c + 0x4646464646464646ULL)) & 0x8080808080808080ULL;  // non-digit bytes
+                int k = bad ? __builtin_ctzll(bad) >> 3 : 8;
+                if (k) x = x * POW10[k] + swar8(d << (8 * (8 - k)));
+                p += k;
+                if (k == 8) continue;
+            } else {
+                while (p < end && (unsigned)(*p - '0') < 10) x = x * 10 + (*p++ - '0');
+            }
+            break;
+        }
+        // More than 10 significant digits can't be an int (and x may have wrapped).
+        if (p == first || (p < end && (unsigned char)*p > ' ') || p - sig > 10 ||
+            x > (uint64_t)INT_MAX + neg) {
+            skipped++;
+            while (p < end && (unsigned char)*p > ' ') p++;
+            continue;
+        }
+        out.push_back(neg ? (int)(0 - (uint32_t)x) : (int)x);
+    }
+    return skipped;
+}
+
+// Same result as parseInts, with the text split into chunks whose edges
+// are moved forward to whitespace so no token is cut. Each thread parses
+// its chunks into its own vector; the pieces are then copied into place
+// (in parallel) so the output keeps the original order. The number of
+// skipped tokens goes to *bad when it is given.
+inline vector<int> parseIntsParallel(const char* p, const char* end, int threads = 0, size_t* bad = nullptr) {
+    if (threads <= 0) threads = max(1u, thread::hardware_concurrency());
+    size_t n = end - p;
+    if (threads == 1 || n < (2 << 20)) {
+        vector<int> out;
+        out.reserve(n / 4);
+        size_t b = parseInts(p, end, out);
+        if (bad) *bad = b;
+        return out;
+    }
+    int chunks = (int)max<size_t>(1, min<size_t>(threads * 4, n >> 20));  // >= 1 MB each
+    vector<const char*> cut(chunks + 1, end);
+    for (int i = 0; i < chunks; i++) {
+        const char* b = p + n * i / chunks;
+        while (b > p && b < end && (unsigned char)b[-1] > ' ') b++;
+        cut[i] = b;
+    }
+    vector<vector<int>> parts(chunks);
+    vector<size_t> skipped(chunks);
+    auto runAll = [&](auto job) {
+        vector<thread> pool;
+        for (int t = 1; t < min(threads, chunks); t++) pool.emplace_back(job, t);
+        job(0);
+        for (auto& th : pool) th.join();
+    };
+    int stride = min(threads, chunks);
+    runAll([&](int t) {
+        for (int i = t; i < chunks; i += stride) {
+            parts[i].reserve((cut[i + 1] - cut[i]) / 4);
+            skipped[i] = parseInts(cut[i], cut[i + 1], parts[i]);
+        }
+    });
+    vector<size_t> at(chunks + 1, 0);
+    for (int i = 0; i < chunks; i++) at[i + 1] = at[i] + parts[i].size();
+    vector<int> out(at[chunks]);
+    if (bad) {
+        *bad = 0;
+        for (size_t k : skipped) *bad += k;
+    }
+    runAll([&](int t) {
+        for (int i = t; i < chunks; i += stride) {
+            copy(parts[i].begin(), parts[i].end(), out.begin() + at[i]);
+            vector<int>().swap(parts[i]);
+        }
+    });
+    return out;
+}
+
+// nums.txt format ("n\n v1 ... vn") straight from a mapping. Empty if
+// any token isn't an int: skipping one would shift the values after it.
+inline vector<int> loadNums(const string& path) {
+    Mapping txt(path);
+    size_t bad;
+    vector<int> all = parseIntsParallel(txt.data, txt.data + txt.size, 0, &bad);
+    if (bad || all.empty() || all[0] < 0 || (size_t)all[0] > all.size() - 1) return {};
+    return vector<int>(all.begin() + 1, all.begin() + 1 + all[0]);
+}
+
+// "n\n v1 v2 ... vn" text (the nums.txt format) <-> one I32 column.
+bool textToColumns(const string& txtPath, const string& colPath) {
+    Mapping txt(txtPath);
+    size_t bad;
+    vector<int> all = parseIntsParallel(txt.data, txt.data + txt.size, 0, &bad);
+    if (bad || all.empty() || all[0] < 0 || (size_t)all[0] > all.size() - 1) return false;
+    ColumnWriter w;
+    w.add(all.data() + 1, all[0]);
+    return w.save(colPath);
+}
+
+bool columnsToText(const string& colPath, const string& txtPath) {
+    ColumnFile cf(colPath);
+    Span<int> v = cf.column<int>(0, true);
+    AsyncWriter out(txtPath);
+    out << v.size() << '\n';
+    for (size_t i = 0; i < v.size(); i++) out << v[i] << (i + 1 == v.size() ? '\n' : ' ');
+    return out.close();
+}
+
+// ==========================================
+// PACKED INTEGER FILES - delta + zigzag + 128-value bit-packed blocks
+// ==========================================
+// Sorted IDs and small counts need a few bits each, not 4 bytes (or ~7 as
+// text). Layout: "INTPACK1", then blocks of [u8 bits][u8 count-1][16*bits
+// bytes]. A block holds up to 128 values as zigzagged deltas from the
+// previous value, each stored in `bits` bits. Value i of a block sits in
+// lane i % 4, and each lane is packed into its own 32-bit words,
+// interleaved, so one 128-bit load yields 4 consecutive values (the
+// SIMD-BP128 layout). Deltas use 32-bit wraparound, so any int round-trips.
+static const char PACK_MAGIC[8] = {'I', 'N', 'T', 'P', 'A', 'C', 'K', '1'};
+
+inline uint32_t zigzag(uint32_t d) { return (d << 1) ^ (0 - (d >> 31)); }
+
+// z[128] -> 4*bits words at w.
+inline void packBlock(const uint32_t* z, int bits, uint32_t* w) {
+    memset(w, 0, 16 * bits);
+    for (int lane = 0; lane < 4; lane++)
+        for (int r = 0, bit = 0; r < 32; r++, bit += bits) {
+            uint32_t v = z[r * 4 + lane];
+            int k = bit >> 5, off = bit & 31;
+            w[k * 4 + lane] |= v << off;
+            if (off + bits > 32) w[(k + 1) * 4 + lane] |= v >> (32 - off);
+        }
+}
+
+#if defined(__SSE2__)
+// One block with the width known at compile time, so every shift and load
+// below is a constant once the loop is unrolled.
+template <int BITS>
+inline uint32_t unpackSSE(const char* src, uint32_t prev, int* out) {
+    const __m128i* w = (const __m128i*)src;
+    const __m128i mask = _mm_set1_epi32(BITS == 32 ? ~0u : (1u << BITS) - 1), one = _mm_set1_epi32(1);
+    __m128i last = _mm_set1_epi32(prev), cur = BITS ? _mm_loadu_si128(w) : last;
+#pragma GCC unroll 32
+    for (int r = 0; r < 32; r++) {
+        const int off = r * BITS % 32, k = r * BITS / 32;
+        __m128i v = _mm_srli_epi32(cur, off);
+        if (off + BITS >= 32 && k + 1 < BITS) {
+            cur = _mm_loadu_si128(w + k + 1);
+            if (off + BITS > 32) v = _mm_or_si128(v, _mm_slli_epi32(cur, 32 - off));
+        }
+        v = _mm_and_si128(v, mask);
+        v = _mm_xor_si128(_mm_srli_epi32(v, 1), _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(v, one)));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));  // prefix sum of the 4 deltas
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        last = _mm_add_epi32(v, last);
+        _mm_storeu_si128((__m128i*)out + r, last);
+        last = _mm_shuffle_epi32(last, 0xFF);
+    }
+    return _mm_cvtsi128_si32(last);
+}
+
+template <size_t... B>
+inline uint32_t unpackDispatch(const char* src, int bits, uint32_t prev, int* out, index_sequence<B...>) {
+    using Fn = uint32_t (*)(const char*, uint32_t, int*);
+    static constexpr Fn table[] = {unpackSSE<B>...};
+    return table[bits](src, prev, out);
+}
+#endif
+
+// Inverse of packBlock + zigzag + delta: writes 128 values, returns the last.
+inline uint32_t unpackBlock(const char* src, int bits, uint32_t prev, int* out) {
+#if defined(__SSE2__)
+    return unpackDispatch(src, bits, prev, out, make_index_sequence<33>());
+#else
+    uint32_t w[128] = {};
+    memcpy(w, src, 16 * bits);
+    uint32_t mask = bits == 32 ? ~0u : (1u << bits) - 1;
+    for (int r = 0; r < 32; r++)
+        for (int lane = 0; lane < 4; lane++) {
+            int bit = r * bits, k = bit >> 5, off = bit & 31;
+            uint64_t two = w[k * 4 + lane] | (off + bits > 32 ? (uint64_t)w[(k + 1) * 4 + lane] << 32 : 0);
+            uint32_t z = (two >> off) & mask;
+            out[r * 4 + lane] = (int)(prev += (z >> 1) ^ (0 - (z & 1)));
+        }
+    return prev;
+#endif
+}
+
+// Streams ints into a packed file: w.put(x) ...; w.close().
+class PackedWriter {
+public:
+    explicit PackedWriter(const string& path) : out(path) { out.write(PACK_MAGIC, 8); }
+    ~PackedWriter() { close(); }
+
+    void put(int v) {
+        uint32_t d = (uint32_t)v - prev;
+        prev = v;
+        z[n++] = zigzag(d);
+        if (n == 128) emit();
+    }
+    bool close() {
+        if (n) emit();
+        return out.close();
+    }
+
+private:
+    AsyncWriter out;
+    uint32_t z[128], words[128], prev = 0;
+    int n = 0;
+
+    void emit() {
+        uint32_t any = 0;
+        for (int i = 0; i < n; i++) any |= z[i];
+        for (int i = n; i < 128; i++) z[i] = 0;  // padding decodes as repeats
+        int bits = any ? 32 - __builtin_clz(any) : 0;
+        packBlock(z, bits, words);
+        out << (char)bits << (char)(n - 1);
+        out.write((const char*)words, 16 * bits);
+        n = 0;
+    }
+};
+
+// Same reading interface as MappedFile: next(v) until false, or
+// for (int v : PackedView(r)). nextBlock() is the fast bulk path.
+// Throws runtime_error on a malformed file.
+class PackedReader {
+public:
+    explicit PackedReader(const string& path) : m(path) {
+        if (m.size < 8 || memcmp(m.data, PACK_MAGIC, 8) != 0) throw runtime_error(path + ": not a packed int file");
+    }
+
+    // Decodes up to 128 values into out (room for 128 needed); 0 at the end.
+    size_t nextBlock(int* out) {
+        if (at == m.size) return 0;
+        int bits = blockBits(at);
+        size_t n = (unsigned char)m.data[at + 1] + 1;
+        unpackBlock(m.data + at + 2, bits, prev, out);
+        prev = out[n - 1];
+        at += 2 + 16 * bits;
+        return n;
+    }
+    bool next(int& v) {
+        if (i == n) {
+            n = nextBlock(buf), i = 0;
+            if (!n) return false;
+        }
+        v = buf[i++];
+        return true;
+    }
+    vector<int> readAll() {  // everything not yet read
+        size_t total = n - i;  // values next() has buffered but not returned
+        for (size_t a = at; a < m.size; a += 2 + 16 * blockBits(a)) total += (unsigned char)m.data[a + 1] + 1;
+        vector<int> v(total + 128);
+        size_t got = copy(buf + i, buf + n, v.begin()) - v.begin();
+        i = n;
+        while (got < total) got += nextBlock(v.data() + got);
+        v.resize(total);
+        return v;
+    }
+
+private:
+    Mapping m;
+    size_t at = 8, i = 0, n = 0;
+    uint32_t prev = 0;
+    int buf[128];
+
+    int blockBits(size_t a) const {
+        int bits = m.size - a < 2 ? 99 : (unsigned char)m.data[a];
+        if (bits > 32 || m.size - a - 2 < 16u * bits) throw runtime_error("packed file truncated");
+        return bits;
+    }
+};
+
+// for (int v : PackedView(reader)) { ... }
+struct PackedView {
+    PackedReader& r;
+    explicit PackedView(PackedReader& pr) : r(pr) {}
+
+    struct End {};
+    struct iterator {
+        PackedReader* r;
+        int cur;
+        bool done = false;
+        int operator*() const { return cur; }
+        iterator& operator++() { done = !r->next(cur); return *this; }
+        bool operator!=(End) const { return !done; }
+    };
+    iterator begin() { iterator it{&r, 0, false}; return ++it; }
+    End end() { return {}; }
+};
+
+// nums.txt -> packed values (the n header is not stored).
+bool textToPacked(const string& txtPath, const string& packPath) {
+    vector<int> nums = loadNums(txtPath);
+    PackedWriter w(packPath);
+    for (int x : nums) w.put(x);
+    return w.close();
+}
+
+#ifdef BENCH
+// ==========================================
+// BENCHMARKS - g++ -O2 -DBENCH 19_file_io.cpp && ./a.out [name ...]
+// ==========================================
+double nowSec() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Writes `mb` MB of log-like lines (20..200 chars) to path.
+void makeLog(const char* path, size_t mb) {
+    ofstream out(path, ios::binary);
+    string line;
+    unsigned x = 12345;
+    for (size_t written = 0; written < (mb << 20);) {
+        x = x * 1103515245 + 12345;
+        line.assign(20 + (x >> 8) % 180, 'a' + (x >> 20) % 26);
+        line += '\n';
+        out << line;
+        written += line.size();
+    }
+}
+
+// getline vs LineView over a 1 GB file (page cache warm for both).
+void benchLines() {
+    const char* path = "/tmp/fileio_bench_lines.txt";
+    makeLog(path, 1024);
+    auto report = [](const char* name, double t, size_t bytes, size_t lines) {
+        printf("  %-24s %.3f s  %5.2f GB/s  %zu lines\n", name, t, bytes / t / 1e9, lines);
+    };
+    size_t bytes = 0, lines = 0;
+    double t0 = nowSec();
+    {
+        ifstream in(path);
+        string line;
+        while (getline(in, line)) bytes += line.size() + 1, lines++;
+    }
+    report("getline", nowSec() - t0, bytes, lines);
+    for (size_t window : {MappedFile::DEFAULT_WINDOW, (size_t)1 << 20}) {
+        bytes = lines = 0;
+        t0 = nowSec();
+        MappedFile f(path, window);
+        for (string_view line : LineView(f)) bytes += line.size() + 1, lines++;
+        report(window == MappedFile::DEFAULT_WINDOW ? "LineView (256 MB window)" : "LineView (1 MB window)",
+               nowSec() - t0, bytes, lines);
+    }
+    remove(path);
+}
+
+// 10^8 ints: numIn >> arr[i] from text vs mapping the column file.
+void benchColumns() {
+    const size_t N = 100000000;
+    const char* txt = "/tmp/fileio_bench_nums.txt";
+    const char* col = "/tmp/fileio_bench_nums.col";
+    {
+        vector<int> v(N);
+        unsigned x = 1;
+        for (int& e : v) x = x * 1103515245 + 12345, e = (int)(x >> 1) - (1 << 30);
+        ColumnWriter w;
+        w.add(v);
+        w.save(col);
+    }
+    double t0 = nowSec();
+    columnsToText(col, txt);
+    printf("  columnsToText %.3f s\n", nowSec() - t0);
+    t0 = nowSec();
+    textToColumns(txt, col);
+    printf("  textToColumns %.3f s\n", nowSec() - t0);
+
+    long long sumText = 0, sumBin = 0;
+    t0 = nowSec();
+    {
+        ifstream numIn(txt);
+        int n;
+        numIn >> n;
+        vector<int> arr(n);
+        for (int i = 0; i < n; i++) numIn >> arr[i];
+        for (int v : arr) sumText += v;
+    }
+    printf("  text load (>>)   %.3f s\n", nowSec() - t0);
+    t0 = nowSec();
+    {
+        ColumnFile cf(col);
+        Span<int> arr = cf.column<int>(0);
+        double tMap = nowSec() - t0;
+        printf("  column map       %.6f s (%zu ints)\n", tMap, arr.size());
+        double t1 = nowSec();
+        bool ok = cf.verify(0);
+        printf("  + verify         %.3f s (%s)\n", nowSec() - t1, ok ? "ok" : "BAD");
+        for (int v : arr) sumBin += v;
+    }
+    printf("  sums %s\n", sumText == sumBin ? "match" : "MISMATCH");
+    remove(txt);
+    remove(col);
+}
+
+// 10^8 ints of text: >> vs scalar-loop vs SWAR parseInts vs parseIntsParallel.
+void benchParse() {
+    const size_t N = 100000000;
+    const char* txt = "/tmp/fileio_bench_parse.txt";
+    {
+        ofstream out(txt);
+        string buf = to_string(N) + "\n";
+        unsigned x = 7;
+        for (size_t i = 0; i < N; i++) {
+            x = x * 1103515245 + 12345;
+            buf += to_string((int)(x >> 1) - (1 << 30));
+            buf += ' ';
+            if (buf.size() > (1 << 20)) out << buf, buf.clear();
+        }
+        out << buf;
+    }
+    Mapping m(txt);
+    auto report = [&](const char* name, double t, size_t count, long long sum) {
+        printf("  %-22s %.3f s  %5.2f GB/s  %zu ints  sum=%lld\n", name, t, m.size / t / 1e9, count, sum);
+    };
+    auto sumOf = [](const vector<int>& v) { long long s = 0; for (int x : v) s += x; return s; };
+    double t0 = nowSec();
+    {
+        vector<int> v;
+        const char* p = m.data;
+        const char* e = m.data + m.size;
+        while (p < e) {  // the one-digit-at-a-time loop parseInts used before
+            while (p < e && (unsigned char)*p <= ' ') p++;
+            if (p == e) break;
+            bool neg = *p == '-';
+            if (neg) p++;
+            long long x = 0;
+            while (p < e && (unsigned)(*p - '0') < 10) x = x * 10 + (*p++ - '0');
+            v.push_back(neg ? -x : x);
+        }
+        report("scalar loop", nowSec() - t0, v.size(), sumOf(v));
+    }
+    t0 = nowSec();
+    {
+        vector<int> v;
+        parseInts(m.data, m.data + m.size, v);
+        report("parseInts (SWAR)", nowSec() - t0, v.size(), sumOf(v));
+    }
+    t0 = nowSec();
+    {
+        vector<int> v = parseIntsParallel(m.data, m.data + m.size);
+        char name[32];
+        snprintf(name, sizeof name, "parallel (%u threads)", max(1u, thread::hardware_concurrency()));
+        report(name, nowSec() - t0, v.size(), sumOf(v));
+    }
+    remove(txt);
+}
+
+// 5*10^7 "i i*i\n" lines (~1 GB): ofstream with endl / with '\n' vs AsyncWriter.
+void benchWriter() {
+    const long long N = 50000000;
+    const char* path = "/tmp/fileio_bench_out.txt";
+    auto report = [&](const char* name, double t) {
+        struct stat st;
+        stat(path, &st);
+        printf("  %-20s %.3f s  %5.2f GB/s  %lld bytes\n", name, t, st.st_size / t / 1e9, (long long)st.st_size);
+        remove(path);
+    };
+    double t0 = nowSec();
+    {
+        ofstream out(path);
+        for (long long i = 0; i < N / 10; i++) out << i << ' ' << i * i << endl;  // 1/10 of N - endl is slow
+    }
+    report("ofstream endl (N/10)", nowSec() - t0);
+    t0 = nowSec();
+    {
+        ofstream out(path);
+        for (long long i = 0; i < N; i++) out << i << ' ' << i * i << '\n';
+    }
+    report("ofstream '\\n'", nowSec() - t0);
+    t0 = nowSec();
+    {
+        AsyncWriter out(path);
+        for (long long i = 0; i < N; i++) out << i << ' ' << i * i << '\n';
+        if (!out.close()) printf("  error: %s\n", out.error().c_str());
+    }
+    report("AsyncWriter", nowSec() - t0);
+}
+
+// Durable 100-byte appends for ~2 s: write+fdatasync per record vs
+// DurableLog with 1..64 appending threads.
+void benchLog() {
+    const char* path = "/tmp/fileio_bench_audit.log";
+    const string rec(100, 'r');
+    auto report = [](const char* name, double t, size_t recs, uint64_t syncs) {
+        printf("  %-22s %8.0f appends/s  %6.1f records/sync\n", name, recs / t, (double)recs / max<uint64_t>(syncs, 1));
+    };
+    remove(path);
+    {
+        int fd = open(path, O_WRONLY | O_CREAT | O_APPEND, 0644);
+        size_t n = 0;
+        double t0 = nowSec();
+        while (nowSec() - t0 < 2) {
+            if (write(fd, rec.data(), rec.size()) != (ssize_t)rec.size() || fdatasync(fd) != 0) break;
+            n++;
+        }
+        report("fdatasync per record", nowSec() - t0, n, n);
+        close(fd);
+    }
+    for (int threads : {1, 8, 64}) {
+        remove(path);
+        DurableLog log(path);
+        atomic<size_t> n{0};
+        double t0 = nowSec();
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++)
+            pool.emplace_back([&] {
+                while (nowSec() - t0 < 2 && log.append(rec)) n++;
+            });
+        for (auto& th : pool) th.join();
+        char name[32];
+        snprintf(name, sizeof name, "DurableLog x%d", threads);
+        report(name, nowSec() - t0, n, log.syncCount());
+        if (!log.error().empty()) printf("  error: %s\n", log.error().c_str());
+    }
+    size_t replayed = DurableLog::replay(path, [](string_view) {});
+    printf("  replayed %zu records from the last run\n", replayed);
+    remove(path);
+}
+
+// 10^8 sorted IDs and 10^8 small counts: size vs text, encode, then decode
+// into a new vector / a reused 128-int block / through PackedView, against
+// parseInts over the same values as text.
+void benchPacked() {
+    const size_t N = 100000000;
+    const char* txt = "/tmp/fileio_bench_packed.txt";
+    const char* pk = "/tmp/fileio_bench_packed.pk";
+    for (int sorted : {1, 0}) {
+        printf(" %s\n", sorted ? "sorted ids (gaps 1..64)" : "counts 0..99");
+        vector<int> v(N);
+        unsigned x = 99, id = 0;
+        for (size_t i = 0; i < N; i++) x = x * 1103515245 + 12345, v[i] = sorted ? id += 1 + (x >> 16) % 64 : (x >> 16) % 100;
+        {
+            AsyncWriter out(txt);
+            for (int y : v) out << y << ' ';
+        }
+        double t0 = nowSec();
+        {
+            PackedWriter w(pk);
+            for (int y : v) w.put(y);
+        }
+        double enc = nowSec() - t0;
+        struct stat st;
+        stat(txt, &st);
+        long long txtBytes = st.st_size;
+        stat(pk, &st);
+        printf("  text %lld bytes, packed %lld bytes (%.2f bits/int), encode %.0f M ints/s\n",
+               txtBytes, (long long)st.st_size, st.st_size * 8.0 / N, N / enc / 1e6);
+        auto report = [&](const char* name, double t, bool ok) {
+            printf("  %-14s %.3f s  %6.0f M ints/s%s\n", name, t, N / t / 1e6, ok ? "" : "  MISMATCH");
+        };
+        t0 = nowSec();
+        {
+            Mapping m(txt);
+            vector<int> got;
+            got.reserve(N);
+            parseInts(m.data, m.data + m.size, got);
+            report("parseInts text", nowSec() - t0, got == v);
+        }
+        PackedReader warm(pk);  // fault the file in once so both runs see the page cache
+        warm.readAll();
+        t0 = nowSec();
+        {
+            PackedReader r(pk);
+            vector<int> got = r.readAll();
+            report("readAll", nowSec() - t0, got == v);
+        }
+        t0 = nowSec();
+        {
+            PackedReader r(pk);
+            int blk[128];
+            long long sum = 0;
+            for (size_t n; (n = r.nextBlock(blk));) sum += blk[n - 1];  // decode cost only
+            double t = nowSec() - t0;
+            for (size_t i = 127; i < N + 127; i += 128) sum -= v[min(i, N - 1)];
+            report("nextBlock", t, sum == 0);
+        }
+        t0 = nowSec();
+        {
+            PackedReader r(pk);
+            long long sum = 0;
+            for (int y : PackedView(r)) sum += y;
+            double t = nowSec() - t0;
+            for (int y : v) sum -= y;
+            report("PackedView", t, sum == 0);
+        }
+    }
+    remove(txt);
+    remove(pk);
+}
+
+// 256 MB log to a file and to a pipe: the getline / cout << endl loop vs
+// each copyFd path (page cache warm). The pipe is drained by a thread that
+// splices it into /dev/null, so the reader side costs no copy.
+void benchCat() {
+    const char* src = "/tmp/fileio_bench_cat.txt";
+    const char* dst = "/tmp/fileio_bench_cat.out";
+    makeLog(src, 256);
+    struct stat st;
+    stat(src, &st);
+    const char* names[] = {"copy_file_range", "sendfile", "splice", "read/write"};
+    for (int toPipe : {0, 1}) {
+        printf(" to %s\n", toPipe ? "a pipe" : "a file");
+        for (int way = -1; way < 4; way++) {
+            if (way == (toPipe ? 0 : 2)) continue;  // copy_file_range needs a file, splice a pipe
+            int out, p[2] = {-1, -1};
+            thread drain;
+            if (toPipe) {
+                if (pipe(p) != 0) return;
+                fcntl(p[1], F_SETPIPE_SZ, 1 << 20);
+                out = p[1];
+                drain = thread([r = p[0]] {
+                    int null = open("/dev/null", O_WRONLY);
+                    while (splice(r, nullptr, null, nullptr, 1 << 20, SPLICE_F_MOVE) > 0) {}
+                    close(null);
+                });
+            } else {
+                remove(dst);
+                sync();  // don't time the previous run's writeback
+                out = open(dst, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            }
+            double t0 = nowSec();
+            CopyVia used = CopyVia::ReadWrite;
+            bool ok;
+            if (way < 0) {
+                fflush(stdout);
+                cout.flush();
+                int saved = dup(STDOUT_FILENO);
+                dup2(out, STDOUT_FILENO);
+                ifstream in(src);
+                string line;
+                while (getline(in, line)) cout << line << endl;
+                dup2(saved, STDOUT_FILENO);
+                close(saved);
+                ok = (bool)cout;
+            } else {
+                int in = open(src, O_RDONLY);
+                ok = copyFd(in, out, (CopyVia)way, &used) == st.st_size && (int)used == way;
+                close(in);
+            }
+            close(out);
+            if (drain.joinable()) drain.join(), close(p[0]);
+            double t = nowSec() - t0;
+            printf("  %-22s %.3f s  %5.2f GB/s%s\n", way < 0 ? "getline + cout << endl" : names[way], t,
+                   st.st_size / t / 1e9, ok ? "" : "  (failed or fell back)");
+        }
+    }
+    remove(src);
+    remove(dst);
+}
+
+int runBenchmarks(int argc, char** argv) {
+    struct Case { const char* name; void (*run)(); };
+    static const Case cases[] = {
+        {"lines", benchLines},
+        {"columns", benchColumns},
+        {"parse", benchParse},
+        {"writer", benchWriter},
+        {"log", benchLog},
+        {"packed", benchPacked},
+        {"cat", benchCat},
+    };
+    for (const Case& c : cases) {
+        bool pick = argc < 2;
+        for (int i = 1; i < argc; i++) if (!strcmp(argv[i], c.name)) pick = true;
+        if (!pick) continue;
+        printf("[%s]\n", c.name);
+        c.run();
+        fflush(stdout);
+    }
+    return 0;
+}
+#endif
+
+int main(int argc, char** argv) {
+#ifdef BENCH
+    return runBenchmarks(argc, argv);
+#endif
+    (void)argc, (void)argv;
     // === WRITING ===
     ofstream out("output.txt");
     out << "Hello World\n";
@@ -21,6 +1415,16 @@ int main() {
     append << "Appended line\n";
     append.close();
     
+    // Records that must survive a crash: append() returns once on disk
+    DurableLog audit("audit.log");
+    audit.append("user=42 action=login");
+    cout << "audit.log records: " << DurableLog::replay("audit.log", [](string_view) {}) << endl;
+    
+    // Big outputs: no endl, formatting overlaps the disk writes
+    AsyncWriter big("squares.txt");
+    for (int i = 1; i <= 1000; i++) big << i << ' ' << i * i << '\n';
+    if (!big.close()) cout << "squares.txt: " << big.error() << endl;
+    
     // === READING ===
     // Line by line
     ifstream in("output.txt");
@@ -30,6 +1434,14 @@ int main() {
     }
     in.close();
     
+    // Large files: map instead of copying every line into a string
+    MappedFile mapped("output.txt");
+    int count = 0;
+    for (string_view l : LineView(mapped)) {
+        if (!l.empty()) count++;
+    }
+    cout << "Mapped lines: " << count << endl;
+    
     // Read numbers into vector
     ofstream numFile("nums.txt");
     numFile << "5\n1 2 3 4 5\n";
@@ -46,6 +1458,28 @@ int main() {
     for (int x : arr) cout << x << " ";
     cout << endl;
     
+    // Just passing a file on? The kernel copies it, no getline loop
+    catFile("nums.txt");
+    
+    // Big text files: map + parse on all cores
+    vector<int> fast = loadNums("nums.txt");
+    cout << "loadNums: " << fast.size() << " values" << endl;
+    
+    // Binary column file: convert once, then load with a single mmap
+    textToColumns("nums.txt", "nums.col");
+    ColumnFile cols("nums.col");
+    Span<int> loaded = cols.column<int>(0, true);  // true = verify checksum
+    cout << "From nums.col: ";
+    for (int x : loaded) cout << x << " ";
+    cout << endl;
+    
+    // Sorted IDs / small counts: a few bits per value instead of text
+    textToPacked("nums.txt", "nums.pk");
+    PackedReader packed("nums.pk");
+    cout << "From nums.pk: ";
+    for (int x : PackedView(packed)) cout << x << " ";
+    cout << endl;
+    
     // === FOR COMPETITIVE PROGRAMMING ===
     // Redirect stdin/stdout:
     // freopen("input.txt", "r", stdin);
@@ -61,9 +1495,17 @@ int main() {
  * fstream  - both
  * 
  * ios::app - append
+ * DurableLog log(path); log.append(rec) - crash-safe append, group fsync
  * ios::binary - binary mode
  * 
+ * AsyncWriter w(path); w << x << '\n'; w.close() - big outputs
+ * catFile(path) - file -> stdout without user-space copies
  * getline(stream, str) - read line
+ * MappedFile f(path); for (string_view l : LineView(f)) - fast lines
+ * loadNums(path) - nums.txt parsed on all cores
+ * textToColumns / columnsToText - nums.txt <-> binary nums.col
+ * ColumnFile(path).column<int>(0) - zero-copy Span<int>
+ * PackedWriter / PackedReader - delta + bit-packed ints, SSE2 decode
  * stream >> var - read value
  * stream << val - write value
  */
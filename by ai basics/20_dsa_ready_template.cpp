@@ -8,6 +8,14 @@
  */
 
 #include <bits/stdc++.h>  // Includes everything (use in CP only)
+#include <fcntl.h>        // POSIX bits used by Scanner (not in bits/stdc++)
+#include <malloc.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>    // __rdtsc for trace timestamps
+#endif
 using namespace std;
 
 // Type aliases for convenience
@@ -37,8 +45,135 @@ const double PI = acos(-1.0);
 #define rep(i, a, b) for (int i = (a); i < (b); i++)
 #define per(i, a, b) for (int i = (b) - 1; i >= (a); i--)
 
-// Debug macro (remove for submission)
-#define dbg(x) cerr << #x << " = " << x << endl
+// ============================================
+// TRACE - dbg() into a per-thread ring buffer
+// ============================================
+// dbg(x), trace("label") and trace("label", value) store a timestamped
+// binary event in the calling thread's ring (the last TraceRing::CAP are
+// kept). Nothing is formatted until traceDump(), which also runs at exit.
+// Build with -DLOCAL to record; otherwise the macros expand to nothing, so
+// they can stay in submitted code.
+struct TraceEvent {
+    enum Kind : uint8_t { NONE, INT, UINT, REAL, TEXT };
+    ull ts;
+    const char* label;
+    Kind kind;
+    union { ll i; ull u; double d; char text[24]; };
+};
+
+inline ull traceClock() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+struct TraceRing {
+    static const int CAP = 1 << 16;
+    atomic<ull> head{0};
+    ull shown = 0;  // events already printed by traceDump()
+    int tid = 0;
+    TraceEvent ev[CAP];
+};
+
+// Rings are never freed: a thread's events must survive the thread itself.
+struct TraceRegistry {
+    mutex mu;
+    vector<TraceRing*> rings;
+    ull tick0 = traceClock();
+    chrono::steady_clock::time_point time0 = chrono::steady_clock::now();
+};
+TraceRegistry& traceRegistry() {
+    static TraceRegistry* reg = new TraceRegistry();
+    return *reg;
+}
+
+// Prints every event not shown yet, all threads merged by time. Call it
+// when writers are quiet (a ring being written may be overwritten mid-read).
+void traceDump() {
+    TraceRegistry& reg = traceRegistry();
+    lock_guard<mutex> lock(reg.mu);
+    double nsPerTick = chrono::duration<double, nano>(chrono::steady_clock::now() - reg.time0).count() /
+                       max<ull>(1, traceClock() - reg.tick0);
+    vector<pair<const TraceEvent*, int>> events;
+    for (TraceRing* r : reg.rings) {
+        ull h = r->head.load(memory_order_acquire);
+        for (ull i = max(r->shown, h > TraceRing::CAP ? h - TraceRing::CAP : 0); i < h; i++)
+            events.pb({&r->ev[i & (TraceRing::CAP - 1)], r->tid});
+        r->shown = h;
+    }
+    sort(all(events), [](auto& a, auto& b) { return a.first->ts < b.first->ts; });
+    for (auto [e, tid] : events) {
+        fprintf(stderr, "[%12.3f us T%d] %s", (e->ts - reg.tick0) * nsPerTick / 1000, tid, e->label);
+        switch (e->kind) {
+            case TraceEvent::INT: fprintf(stderr, " = %lld\n", e->i); break;
+            case TraceEvent::UINT: fprintf(stderr, " = %llu\n", e->u); break;
+            case TraceEvent::REAL: fprintf(stderr, " = %.10g\n", e->d); break;
+            case TraceEvent::TEXT: fprintf(stderr, " = %s\n", e->text); break;
+            default: fprintf(stderr, "\n");
+        }
+    }
+}
+
+TraceRing& traceRing() {
+    thread_local TraceRing* ring = [] {
+        TraceRegistry& reg = traceRegistry();
+        TraceRing* r = new TraceRing();
+        lock_guard<mutex> lock(reg.mu);
+        if (reg.rings.empty()) atexit(traceDump);
+        r->tid = sz(reg.rings);
+        reg.rings.pb(r);
+        return r;
+    }();
+    return *ring;
+}
+
+// Hot path: one thread_local lookup, a timestamp and a 48-byte store.
+// Numbers are stored raw; strings and other printable types are copied
+// (truncated to 23 chars), the latter via ostream - keep those off hot loops.
+template <class T>
+void traceRecord(const char* label, const T& x) {
+    TraceRing& r = traceRing();
+    ull h = r.head.load(memory_order_relaxed);
+    TraceEvent& e = r.ev[h & (TraceRing::CAP - 1)];
+    e.ts = traceClock();
+    e.label = label;
+    auto setText = [&](string_view sv) {
+        size_t n = min(sv.size(), sizeof e.text - 1);
+        memcpy(e.text, sv.data(), n);
+        e.text[n] = 0;
+        e.kind = TraceEvent::TEXT;
+    };
+    if constexpr (is_same_v<T, char>) setText(string_view(&x, 1));
+    else if constexpr (is_floating_point_v<T>) e.kind = TraceEvent::REAL, e.d = x;
+    else if constexpr (is_integral_v<T> && is_signed_v<T>) e.kind = TraceEvent::INT, e.i = x;
+    else if constexpr (is_integral_v<T>) e.kind = TraceEvent::UINT, e.u = x;
+    else if constexpr (is_convertible_v<const T&, string_view>) setText(x);
+    else {
+        ostringstream os;
+        os << x;
+        setText(os.str());
+    }
+    r.head.store(h + 1, memory_order_release);
+}
+void traceRecord(const char* label) {
+    TraceRing& r = traceRing();
+    ull h = r.head.load(memory_order_relaxed);
+    TraceEvent& e = r.ev[h & (TraceRing::CAP - 1)];
+    e.ts = traceClock();
+    e.label = label;
+    e.kind = TraceEvent::NONE;
+    r.head.store(h + 1, memory_order_release);
+}
+
+#ifdef LOCAL
+#define dbg(x) traceRecord(#x, (x))
+#define trace(...) traceRecord(__VA_ARGS__)
+#else
+#define dbg(x) ((void)0)
+#define trace(...) ((void)0)
+#endif
 
 // Fast I/O
 void fastIO() {
@@ -47,10 +182,424 @@ void fastIO() {
     cout.tie(NULL);
 }
 
+// ============================================
+// FAST INPUT - zero-copy Scanner
+// ============================================
+// Maps the input when it is a regular file, otherwise reads it in large
+// blocks. Numbers and tokens are parsed in place: no locale, no per-token
+// allocation. Don't mix with cin on the same stream - Scanner owns the bytes.
+struct Scanner {
+    static const size_t BLOCK = 1 << 20;
+
+    int fd;
+    char* buf = nullptr;        // read() buffer (block mode)
+    size_t cap = 0;
+    char* base = nullptr;       // mapping (mmap mode)
+    size_t mapLen = 0, released = 0;
+    const char* p = nullptr;    // cursor
+    const char* end = nullptr;
+    bool eof = false;
+    bool fail = false;          // sticky, like cin's failbit: a read found no number or no token
+
+    explicit operator bool() const { return !fail; }  // while (sc >> x) ...
+
+    explicit Scanner(int fd_ = 0, bool allowMap = true) : fd(fd_) {
+        struct stat st;
+        if (allowMap && fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            void* m = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                madvise(m, st.st_size, MADV_SEQUENTIAL);
+                base = (char*)m;
+                mapLen = st.st_size;
+                off_t at = lseek(fd, 0, SEEK_CUR);  // skip bytes already consumed
+                p = base + (at > 0 && (size_t)at <= mapLen ? at : 0);
+                end = base + mapLen;
+                eof = true;
+                return;
+            }
+        }
+        cap = BLOCK;
+        buf = new char[cap];
+        p = end = buf;
+    }
+    ~Scanner() {
+        if (base) munmap(base, mapLen);
+        delete[] buf;
+    }
+    Scanner(const Scanner&) = delete;
+    Scanner& operator=(const Scanner&) = delete;
+
+    // Read more bytes, keeping [keep, end) alive (keep is updated).
+    // Returns false once the input is exhausted.
+    bool refill(const char*& keep) {
+        if (eof) return false;
+        size_t kept = end - keep, at = p - keep;
+        if (kept == cap) {  // token larger than the buffer: grow
+            char* nb = new char[cap * 2];
+            memcpy(nb, keep, kept);
+            delete[] buf;
+            buf = nb;
+            cap *= 2;
+        } else {
+            memmove(buf, keep, kept);
+        }
+        ssize_t r;
+        do r = read(fd, buf + kept, cap - kept); while (r < 0 && errno == EINTR);
+        if (r <= 0) { eof = true; r = 0; }
+        keep = buf;
+        p = buf + at;
+        end = buf + kept + r;
+        return r > 0;
+    }
+    bool refill() { const char* k = p; return refill(k); }
+
+    // Skips whitespace; false if nothing is left.
+    bool skip() {
+        for (;;) {
+            while (p < end && (unsigned char)*p <= ' ') ++p;
+            if (p < end) return true;
+            if (!refill()) return false;
+        }
+    }
+
+    // 8 digit bytes (first digit in the low byte, '0' already subtracted)
+    // to their value in three multiply-shift steps.
+    static ull swar8(ull d) {
+        d = (d * 10 + (d >> 8)) & 0x00FF00FF00FF00FFULL;
+        d = (d * 100 + (d >> 16)) & 0x0000FFFF0000FFFFULL;
+        return (d * 10000 + (d >> 32)) & 0xFFFFFFFFULL;
+    }
+
+    ull digits() {
+        static const ull POW10[9] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+        ull x = 0;
+        // SWAR fast path: classify 8 bytes at once, convert the digit run.
+        // Borrows/carries only move towards later bytes, past the first
+        // non-digit, so the digits before it are classified exactly.
+        while (end - p >= 8) {
+            ull c;
+            memcpy(&c, p, 8);
+            ull d = c - 0x3030303030303030ULL;
+            ull bad = (d | (c + 0x4646464646464646ULL)) & 0x8080808080808080ULL;
+            int k = bad ? __builtin_ctzll(bad) >> 3 : 8;
+            if (k == 0) return x;
+            x = x * POW10[k] + swar8(d << (8 * (8 - k)));
+            p += k;
+            if (k < 8) return x;
+        }
+        for (;;) {
+            while (p < end && (unsigned)(*p - '0') < 10) x = x * 10 + (*p++ - '0');
+            if (p < end || !refill()) return x;
+        }
+    }
+
+    // True if the cursor is on a digit (refilling if it sits at the end).
+    bool atDigit() { return (p < end || refill()) && (unsigned)(*p - '0') < 10; }
+
+    // Sets fail and moves past the rest of a token that isn't a number
+    // ("abc", a lone "-", "-5" for an unsigned read) so the next read
+    // doesn't see it again.
+    ull badToken() {
+        fail = true;
+        while ((p < end || refill()) && (unsigned char)*p > ' ') ++p;
+        return 0;
+    }
+
+    ull readULL() {
+        if (!skip()) return fail = true, 0;
+        if (*p == '+') ++p;
+        if (!atDigit()) return badToken();
+        return digits();
+    }
+    ll readLL() {
+        if (!skip()) return fail = true, 0;
+        bool neg = *p == '-';
+        if (neg || *p == '+') ++p;
+        if (!atDigit()) return badToken();
+        ull x = digits();
+        return neg ? (ll)(0 - x) : (ll)x;
+    }
+    int readInt() { return (int)readLL(); }
+
+    // Next whitespace-delimited token; valid until the next read.
+    string_view token() {
+        if (!skip()) return fail = true, string_view();
+        const char* s = p;
+        for (;;) {
+            while (p < end && (unsigned char)*p > ' ') ++p;
+            if (p < end || !refill(s)) return string_view(s, p - s);
+        }
+    }
+
+    // Drops already-parsed pages of a mapping so RSS stays flat on huge files.
+    void release() {
+        if (!base) return;
+        size_t done = (p - base) & ~(size_t)4095;
+        if (done > released) madvise(base + released, done - released, MADV_DONTNEED), released = done;
+    }
+
+    // Streams n integers (n < 0: until EOF) through every reducer's add()
+    // without storing them. Stops early at a token that isn't a number
+    // (fail is then set) or at EOF. Returns how many were read.
+    template <class... R>
+    ll reduce(ll n, R&... rs) {
+        ll i = 0;
+        for (; i != n && !fail && skip(); i++) {
+            ll x = readLL();
+            if (fail) break;
+            (rs.add(x), ...);
+            if ((i & 0xFFFFF) == 0xFFFFF) release();
+        }
+        return i;
+    }
+
+    Scanner& operator>>(int& x) { x = readInt(); return *this; }
+    Scanner& operator>>(ll& x) { x = readLL(); return *this; }
+    Scanner& operator>>(ull& x) { x = readULL(); return *this; }
+    Scanner& operator>>(string_view& s) { s = token(); return *this; }
+    Scanner& operator>>(string& s) { s = token(); return *this; }
+    Scanner& operator>>(char& c) { c = skip() ? *p++ : (fail = true, 0); return *this; }
+};
+
+Scanner sc;  // use like cin: sc >> n;
+
+// Reducers for Scanner::reduce - each sees every value once, in order.
+struct SumR { ll v = 0; void add(ll x) { v += x; } };
+struct MinR { ll v = LLONG_MAX; void add(ll x) { v = min(v, x); } };
+struct MaxR { ll v = LLONG_MIN; void add(ll x) { v = max(v, x); } };
+struct XorR { ll v = 0; void add(ll x) { v ^= x; } };
+struct HistR {  // counts of lo..hi, everything else in `other`
+    ll lo;
+    vll cnt;
+    ll other = 0;
+    HistR(ll lo_, ll hi) : lo(lo_), cnt(hi - lo_ + 1) {}
+    void add(ll x) {
+        if (x >= lo && x - lo < sz(cnt)) cnt[x - lo]++;
+        else other++;
+    }
+};
+template <class Vec>
+struct CollectR {  // opt-in: keep the values too
+    Vec& out;
+    void add(ll x) { out.pb(x); }
+};
+template <class Vec>
+CollectR<Vec> collect(Vec& v) { return {v}; }
+
+// ============================================
+// FAST OUTPUT - append-only buffer
+// ============================================
+bool writeAll(int fd, const char* p, size_t n) {
+    while (n) {
+        ssize_t w = write(fd, p, n);
+        if (w < 0 && errno == EINTR) continue;
+        if (w <= 0) return false;
+        p += w;
+        n -= w;
+    }
+    return true;
+}
+
+template <uint32_t M> struct modint;
+
+// Formats into memory; nothing reaches the fd until flush().
+// Floating point prints like cout: %g with 6 significant digits unless
+// fixed(d) (d digits after the point) or general(d) says otherwise.
+struct Out {
+    string buf;
+    chars_format floatFmt = chars_format::general;
+    int prec = 6;
+
+    Out& fixed(int digits) { floatFmt = chars_format::fixed, prec = max(digits, 0); return *this; }
+    Out& general(int digits = 6) { floatFmt = chars_format::general, prec = max(digits, 0); return *this; }
+
+    Out& operator<<(char c) { buf.push_back(c); return *this; }
+    Out& operator<<(bool b) { buf.push_back(b ? '1' : '0'); return *this; }  // as cout does
+    Out& operator<<(const char* s) { buf.append(s); return *this; }
+    Out& operator<<(string_view s) { buf.append(s); return *this; }
+    Out& operator<<(const string& s) { buf.append(s); return *this; }
+    template <class T, class = enable_if_t<is_arithmetic_v<T> && !is_same_v<T, bool>>>
+    Out& operator<<(T x) {
+        if constexpr (is_floating_point_v<T>) {
+            char tmp[64];
+            auto r = to_chars(tmp, tmp + sizeof tmp, x, floatFmt, prec);
+            if (r.ec == errc()) {
+                buf.append(tmp, r.ptr);
+            } else {  // long fixed output: room for every integer digit plus prec
+                size_t at = buf.size(), room = numeric_limits<T>::max_exponent10 + prec + 8;
+                buf.resize(at + room);
+                buf.resize(to_chars(&buf[at], &buf[at] + room, x, floatFmt, prec).ptr - buf.data());
+            }
+        } else {
+            char tmp[24];
+            buf.append(tmp, to_chars(tmp, tmp + sizeof tmp, x).ptr);
+        }
+        return *this;
+    }
+    template <uint32_t M>
+    Out& operator<<(modint<M> x) { return *this << x.val(); }
+
+    void flush(int fd = 1) {
+        writeAll(fd, buf.data(), buf.size());
+        buf.clear();
+    }
+};
+
+// ============================================
+// THREADS - split [0, n) across cores
+// ============================================
+int threadCount() {
+    static const int n = max(1u, thread::hardware_concurrency());
+    return n;
+}
+
+// Runs f(lo, hi, chunk) over contiguous chunks of [0, n), one thread per
+// chunk. Falls back to a plain call when n is too small to be worth it.
+template <class F>
+int parallelChunks(ll n, ll minChunk, F f, int threads = threadCount()) {
+    int chunks = (int)max(1LL, min<ll>(threads, n / max(1LL, minChunk)));
+    if (chunks == 1) { f(0LL, n, 0); return 1; }
+    vector<thread> pool;
+    rep(c, 0, chunks) pool.emplace_back(f, n * c / chunks, n * (c + 1) / chunks, c);
+    for (auto& th : pool) th.join();
+    return chunks;
+}
+
 // Common utility functions
-ll gcd(ll a, ll b) { return b == 0 ? a : gcd(b, a % b); }
-ll lcm(ll a, ll b) { return a / gcd(a, b) * b; }
+// Binary (Stein) GCD: shifts and subtracts only, no division.
+ll gcd(ll a, ll b) {
+    ull x = a < 0 ? 0 - (ull)a : a, y = b < 0 ? 0 - (ull)b : b;
+    if (!x || !y) return x | y;
+    int xz = __builtin_ctzll(x), yz = __builtin_ctzll(y), shift = min(xz, yz);
+    x >>= xz;
+    y >>= yz;
+    for (;;) {  // both odd, so both < 2^63 and d fits in ll
+        ll d = (ll)y - (ll)x;
+        if (d == 0) return y << shift;
+        y = min(x, y);
+        x = (d < 0 ? -d : d) >> __builtin_ctzll(d);
+    }
+}
+
+// lcm(|a|, |b|), or -1 if it does not fit in ll.
+ll lcm(ll a, ll b) {
+    if (!a || !b) return 0;
+    __int128 r = (__int128)(a / gcd(a, b)) * b;
+    if (r < 0) r = -r;
+    return r > LLONG_MAX ? -1 : (ll)r;
+}
+
+const ll GCD_PAR_MIN = 1 << 20;  // per-thread elements before splitting
+
+ll gcd_many(const vll& v) {
+    vll part(threadCount());
+    int used = parallelChunks(sz(v), GCD_PAR_MIN, [&](ll lo, ll hi, int c) {
+        ll g = 0;
+        // One % first: a running gcd is usually far smaller than v[i].
+        for (ll i = lo; i < hi && g != 1; i++) g = g ? gcd(g, v[i] % g) : v[i];
+        part[c] = g;
+    });
+    ll g = 0;
+    rep(c, 0, used) g = gcd(g, part[c]);
+    return g;
+}
+
+// lcm of all elements, or -1 on overflow.
+ll lcm_reduce(const vll& v) {
+    vll part(threadCount());
+    int used = parallelChunks(sz(v), GCD_PAR_MIN, [&](ll lo, ll hi, int c) {
+        ll l = 1;
+        for (ll i = lo; i < hi && l > 0; i++) l = lcm(l, v[i]);
+        part[c] = l;
+    });
+    ll l = 1;
+    rep(c, 0, used) {
+        if (part[c] < 0) return -1;
+        l = lcm(l, part[c]);
+        if (l < 0) return -1;
+    }
+    return l;
+}
+
+// ============================================
+// MODULAR INTEGER - no hardware divide
+// ============================================
+// modint<M> keeps a compile-time modulus (M < 2^31). Odd moduli use
+// Montgomery form (value * 2^32 mod M), even ones Barrett reduction,
+// so a multiply is two or three integer multiplies instead of a 64-bit %.
+template <uint32_t M>
+struct modint {
+    static_assert(M >= 1 && M < (1u << 31), "modulus must fit in 31 bits");
+    static constexpr bool MONT = M & 1;
+    static constexpr uint32_t NINV = [] {  // -M^-1 mod 2^32 (Newton)
+        uint32_t inv = M;
+        rep(i, 0, 4) inv *= 2 - M * inv;
+        return -inv;
+    }();
+    static constexpr uint32_t R2 = (uint32_t)((0 - (ull)M) % M);  // 2^64 mod M
+    static constexpr ull BARRETT = ~0ULL / M;
+
+    uint32_t v = 0;  // Montgomery form when MONT, plain otherwise
+
+    static constexpr uint32_t reduce(ull t) {
+        if constexpr (MONT) {
+            uint32_t m = (uint32_t)t * NINV;
+            uint32_t r = (uint32_t)((t + (ull)m * M) >> 32);
+            return r >= M ? r - M : r;
+        } else {
+            ull q = (ull)(((unsigned __int128)t * BARRETT) >> 64);
+            ull r = t - q * M;
+            return (uint32_t)(r >= M ? r - M : r);
+        }
+    }
+
+    constexpr modint() {}
+    constexpr modint(ll x) {
+        x %= (ll)M;
+        if (x < 0) x += M;
+        v = MONT ? reduce((ull)x * R2) : (uint32_t)x;
+    }
+    // Wraps an already-reduced value (requires x < M): skips the % and sign fixup.
+    static constexpr modint raw(uint32_t x) { modint r; r.v = MONT ? reduce((ull)x * R2) : x; return r; }
+
+    constexpr uint32_t val() const { return MONT ? reduce(v) : v; }
+    static constexpr uint32_t mod() { return M; }
+
+    constexpr modint& operator+=(modint o) { v += o.v; if (v >= M) v -= M; return *this; }
+    constexpr modint& operator-=(modint o) { v = v >= o.v ? v - o.v : v + M - o.v; return *this; }
+    constexpr modint& operator*=(modint o) { v = reduce((ull)v * o.v); return *this; }
+    constexpr modint& operator/=(modint o) { return *this *= o.inv(); }
+    constexpr modint operator-() const { modint r; r.v = v ? M - v : 0; return r; }
+    friend constexpr modint operator+(modint a, modint b) { return a += b; }
+    friend constexpr modint operator-(modint a, modint b) { return a -= b; }
+    friend constexpr modint operator*(modint a, modint b) { return a *= b; }
+    friend constexpr modint operator/(modint a, modint b) { return a /= b; }
+    friend constexpr bool operator==(modint a, modint b) { return a.v == b.v; }
+    friend constexpr bool operator!=(modint a, modint b) { return a.v != b.v; }
+    friend ostream& operator<<(ostream& os, modint a) { return os << a.val(); }
+
+    constexpr modint pow(ull e) const {
+        modint r = 1, b = *this;
+        for (; e; e >>= 1, b *= b)
+            if (e & 1) r *= b;
+        return r;
+    }
+    // Extended Euclid, so it works for any x coprime to M (not only prime M).
+    constexpr modint inv() const {
+        ll a = val(), m = M, x = 1, y = 0;
+        while (m) {
+            ll q = a / m, r = a - q * m, nx = x - q * y;  // no std::swap: not constexpr in C++17
+            a = m, m = r;
+            x = y, y = nx;
+        }
+        return modint(x);
+    }
+};
+typedef modint<MOD> mint;
+
 ll power(ll base, ll exp, ll mod = MOD) {
+    if (exp < 0) return 1;  // what the loop below always returned
+    if (mod == MOD) return mint(base).pow(exp).val();
     ll result = 1;
     base %= mod;
     while (exp > 0) {
@@ -61,6 +610,179 @@ ll power(ll base, ll exp, ll mod = MOD) {
     return result;
 }
 
+// base^e for every e in exps. Builds base^(d * 256^k) tables once, after
+// which each exponent costs at most 8 multiplies instead of ~2*log2(e).
+// Negative exponents give 1, as in power().
+template <uint32_t M = MOD>
+vll power_many(ll base, const vll& exps) {
+    typedef modint<M> T;
+    vll out(exps.size());
+    if (exps.size() < 64) {
+        rep(i, 0, sz(exps)) out[i] = exps[i] < 0 ? T(1).val() : T(base).pow(exps[i]).val();
+        return out;
+    }
+    ull maxE = 0;
+    for (ll e : exps) if (e > 0) maxE = max(maxE, (ull)e);
+    int windows = 1;
+    while (windows < 8 && (maxE >> (8 * windows))) windows++;
+    vector<T> table(windows * 256);
+    T step = base;  // base^(256^k)
+    rep(k, 0, windows) {
+        T* row = &table[k * 256];
+        row[0] = 1;
+        rep(d, 1, 256) row[d] = row[d - 1] * step;
+        step = row[255] * step;
+    }
+    rep(i, 0, sz(exps)) {
+        ull e = max(exps[i], 0LL);  // e < 0 -> table[0] = 1
+        T r = table[e & 255];
+        for (int k = 1; k < windows; k++) r *= table[k * 256 + ((e >> (8 * k)) & 255)];
+        out[i] = r.val();
+    }
+    return out;
+}
+
+// ============================================
+// COMBINATORICS - factorial tables mod M
+// ============================================
+// fact[0..N] in N multiplies, then invFact[N] from a single inverse and the
+// rest downwards with invFact[i-1] = invFact[i] * i. Needs N < M, M prime.
+// Small N lives in an array and can be constexpr:
+//     constexpr Combinatorics<1000> C;   // built at compile time
+//     Combinatorics<10000000> big;       // heap tables, built at runtime
+template <int N, uint32_t M = MOD>
+struct Combinatorics {
+    static_assert(N >= 1 && (uint32_t)N < M, "need 1 <= N < M");
+    typedef modint<M> T;
+    static constexpr bool SMALL = N <= (1 << 12);
+    typedef conditional_t<SMALL, array<T, N + 1>, vector<T>> Table;
+
+    Table fact{}, invFact{};
+
+    constexpr Combinatorics() {
+        if constexpr (!SMALL) fact.resize(N + 1), invFact.resize(N + 1);
+        fact[0] = 1;
+        rep(i, 1, N + 1) fact[i] = fact[i - 1] * T(i);
+        invFact[N] = fact[N].inv();
+        for (int i = N; i > 0; i--) invFact[i - 1] = invFact[i] * T(i);
+    }
+
+    constexpr T nCr(int n, int r) const {
+        if (r < 0 || r > n) return 0;
+        return fact[n] * invFact[r] * invFact[n - r];
+    }
+    constexpr T nPr(int n, int r) const {
+        if (r < 0 || r > n) return 0;
+        return fact[n] * invFact[n - r];
+    }
+    constexpr T catalan(int n) const { return fact[2 * n] * invFact[n + 1] * invFact[n]; }  // 2n <= N
+    constexpr T inv(int i) const { return invFact[i] * fact[i - 1]; }                     // 1 <= i <= N
+
+    static constexpr size_t bytes() { return 2 * (N + 1) * sizeof(T); }
+};
+
+// ============================================
+// NTT - polynomial multiplication mod P
+// ============================================
+// Iterative radix-2 transform over modint<P>. Twiddles for each level live
+// in their own contiguous table (w^0..w^(len-1)), built once per level on
+// first use, so a butterfly pass streams through a and the roots linearly.
+template <uint32_t P, uint32_t G = 3>
+struct NTT {
+    typedef modint<P> T;
+    static const int MAXLOG = __builtin_ctz(P - 1);
+
+    static const T* roots(int len) {  // primitive (2*len)-th root powers
+        static vector<T> table[MAXLOG];
+        static once_flag once[MAXLOG];
+        int k = __builtin_ctz(len);
+        call_once(once[k], [&] {
+            T w = T(G).pow((P - 1) / (2 * len)), x = 1;
+            table[k].resize(len);
+            for (T& r : table[k]) r = x, x *= w;
+        });
+        return table[k].data();
+    }
+
+    static void transform(vector<T>& a, bool invert) {
+        int n = sz(a);
+        assert((n & (n - 1)) == 0 && n <= (1 << MAXLOG));
+        for (int i = 1, j = 0; i < n; i++) {
+            int bit = n >> 1;
+            for (; j & bit; bit >>= 1) j ^= bit;
+            j ^= bit;
+            if (i < j) swap(a[i], a[j]);
+        }
+        for (int len = 1; len < n; len <<= 1) {
+            const T* w = roots(len);
+            for (int i = 0; i < n; i += 2 * len)
+                rep(j, 0, len) {
+                    T u = a[i + j], v = a[i + j + len] * w[j];
+                    a[i + j] = u + v;
+                    a[i + j + len] = u - v;
+                }
+        }
+        if (invert) {  // inverse = forward with reversed outputs, then / n
+            reverse(a.begin() + 1, a.end());
+            T inv = T(n).inv();
+            for (T& x : a) x *= inv;
+        }
+    }
+
+    // Exact product mod P; inputs are reduced mod P first.
+    static vector<T> multiply(const vll& a, const vll& b) {
+        int need = sz(a) + sz(b) - 1, n = 1;
+        while (n < need) n <<= 1;
+        vector<T> fa(n), fb(n);
+        rep(i, 0, sz(a)) fa[i] = a[i];
+        rep(i, 0, sz(b)) fb[i] = b[i];
+        transform(fa, false);
+        transform(fb, false);
+        rep(i, 0, n) fa[i] *= fb[i];
+        transform(fa, true);
+        fa.resize(need);
+        return fa;
+    }
+};
+
+const int NTT_SCHOOLBOOK = 64;  // below this many terms, O(n*m) wins
+
+// a * b with coefficients mod `mod` (any mod < 2^31). 998244353 is one
+// transform; any other modulus goes through three NTT primes and Garner CRT,
+// exact while len * (mod-1)^2 < 7.8e25.
+vll convolve(const vll& a, const vll& b, ll mod = MOD) {
+    if (a.empty() || b.empty()) return {};
+    auto norm = [&](ll x) { x %= mod; return x < 0 ? x + mod : x; };
+    vll fa(sz(a)), fb(sz(b));
+    rep(i, 0, sz(a)) fa[i] = norm(a[i]);
+    rep(i, 0, sz(b)) fb[i] = norm(b[i]);
+    int need = sz(a) + sz(b) - 1;
+    vll res(need, 0);
+
+    if (min(sz(a), sz(b)) <= NTT_SCHOOLBOOK) {
+        rep(i, 0, sz(fa)) rep(j, 0, sz(fb)) res[i + j] = (res[i + j] + fa[i] * fb[j]) % mod;
+        return res;
+    }
+    const uint32_t P1 = 998244353, P2 = 167772161, P3 = 469762049;
+    auto r1 = NTT<P1>::multiply(fa, fb);
+    if (mod == P1) {
+        rep(i, 0, need) res[i] = r1[i].val();
+        return res;
+    }
+    auto r2 = NTT<P2>::multiply(fa, fb);
+    auto r3 = NTT<P3>::multiply(fa, fb);
+    const modint<P2> inv1_2 = modint<P2>(P1).inv();
+    const modint<P3> inv1_3 = modint<P3>(P1).inv(), inv2_3 = modint<P3>(P2).inv();
+    const ll p12 = (ll)P1 * P2 % mod;
+    rep(i, 0, need) {
+        ll x1 = r1[i].val();
+        ll x2 = ((modint<P2>(r2[i].val()) - modint<P2>(x1)) * inv1_2).val();
+        ll x3 = (((modint<P3>(r3[i].val()) - modint<P3>(x1)) * inv1_3 - modint<P3>(x2)) * inv2_3).val();
+        res[i] = (x1 + x2 * P1 % mod + x3 * p12) % mod;
+    }
+    return res;
+}
+
 // Direction arrays for grid problems
 int dx[] = {0, 0, 1, -1};      // 4 directions
 int dy[] = {1, -1, 0, 0};
@@ -71,34 +793,1023 @@ bool isValid(int x, int y, int n, int m) {
     return x >= 0 && x < n && y >= 0 && y < m;
 }
 
+// ============================================
+// FLAT GRID - padded, no bounds checks
+// ============================================
+// n x m cells in one array with a one-cell WALL border, so neighbours are
+// id + off[d] and never fall outside. Cell (x, y) has id (x+1)*W + (y+1).
+// Distances are indexed by id too: dist[g.id(x, y)], -1 if unreachable.
+template <int DIRS = 4>  // 4 or 8 directions, fixed at compile time
+struct Grid {
+    static_assert(DIRS == 4 || DIRS == 8, "DIRS must be 4 or 8");
+    static constexpr char WALL = '#';
+
+    int n, m, W;
+    vector<char> cell;
+    int off[DIRS];
+
+    Grid(int n_, int m_, char fill = '.') : n(n_), m(m_), W(m_ + 2), cell((n_ + 2) * (m_ + 2), WALL) {
+        rep(x, 0, n) fill_n(&cell[id(x, 0)], m, fill);
+        int base[] = {1, -1, W, -W, W + 1, W - 1, -W + 1, -W - 1};
+        rep(d, 0, DIRS) off[d] = base[d];
+    }
+
+    int id(int x, int y) const { return (x + 1) * W + (y + 1); }
+    pii pos(int i) const { return {i / W - 1, i % W - 1}; }
+    int cells() const { return sz(cell); }
+    char& at(int x, int y) { return cell[id(x, y)]; }
+    void setRow(int x, string_view row) { copy_n(row.data(), min(sz(row), m), &cell[id(x, 0)]); }
+
+    // Visited bitset with every wall (border included) pre-marked, so the
+    // BFS inner loop is one bit test per neighbour.
+    vector<ull> blockedBits() const {
+        vector<ull> bits((cells() + 63) / 64);
+        rep(w, 0, sz(bits)) {
+            ull b = 0;
+            for (int i = w * 64, e = min(cells(), i + 64); i < e; i++) b |= (ull)(cell[i] == WALL) << (i & 63);
+            bits[w] = b;
+        }
+        return bits;
+    }
+
+    vi bfs(const vector<pii>& sources) const {
+        vi dist(cells(), -1);
+        unique_ptr<int[]> q(new int[cells()]);  // each id enters once; no zero-fill
+        vector<ull> seen = blockedBits();
+        int head = 0, tail = 0;
+        for (auto [x, y] : sources) {
+            int s = id(x, y);
+            if (seen[s >> 6] >> (s & 63) & 1) continue;
+            seen[s >> 6] |= 1ULL << (s & 63);
+            dist[s] = 0;
+            q[tail++] = s;
+        }
+        while (head < tail) {
+            int u = q[head++], du = dist[u] + 1;
+            rep(d, 0, DIRS) {
+                int v = u + off[d];
+                ull bit = 1ULL << (v & 63);
+                if (seen[v >> 6] & bit) continue;
+                seen[v >> 6] |= bit;
+                dist[v] = du;
+                q[tail++] = v;
+            }
+        }
+        return dist;
+    }
+    vi bfs(int sx, int sy) const { return bfs(vector<pii>{{sx, sy}}); }
+
+    // 0-1 BFS: cost(u, v) returns 0 or 1 for the step between ids u -> v.
+    template <class Cost>
+    vi bfs01(const vector<pii>& sources, Cost cost) const {
+        vi dist(cells(), INF);
+        vector<ull> done = blockedBits();
+        deque<int> dq;
+        for (auto [x, y] : sources) {
+            int s = id(x, y);
+            if (done[s >> 6] >> (s & 63) & 1) continue;  // wall: unreachable, as in bfs()
+            dist[s] = 0;
+            dq.push_back(s);
+        }
+        while (!dq.empty()) {
+            int u = dq.front();
+            dq.pop_front();
+            if (done[u >> 6] >> (u & 63) & 1) continue;
+            done[u >> 6] |= 1ULL << (u & 63);
+            rep(d, 0, DIRS) {
+                int v = u + off[d];
+                if (done[v >> 6] >> (v & 63) & 1) continue;
+                int w = cost(u, v), nd = dist[u] + w;
+                if (nd >= dist[v]) continue;
+                dist[v] = nd;
+                if (w) dq.push_back(v);
+                else dq.push_front(v);
+            }
+        }
+        for (int& x : dist) if (x == INF) x = -1;
+        return dist;
+    }
+};
+
+// ============================================
+// CSR GRAPH - adjacency in two flat arrays
+// ============================================
+// Neighbours of u are adj[start[u] .. start[u+1]). Built from an edge list
+// with one counting-sort pass: two allocations total instead of one per
+// vertex, and every adjacency walk is a linear scan.
+struct Graph {
+    int n;
+    vi start, adj;
+
+    Graph(int n_, const vpii& edges, bool directed = false) : n(n_), start(n_ + 1, 0) {
+        for (auto [u, v] : edges) {
+            start[u + 1]++;
+            if (!directed) start[v + 1]++;
+        }
+        rep(u, 0, n) start[u + 1] += start[u];
+        adj.resize(start[n]);
+        vi pos(start.begin(), start.end() - 1);
+        for (auto [u, v] : edges) {
+            adj[pos[u]++] = v;
+            if (!directed) adj[pos[v]++] = u;
+        }
+    }
+
+    int deg(int u) const { return start[u + 1] - start[u]; }
+    struct Range {
+        const int *b, *e;
+        const int* begin() const { return b; }
+        const int* end() const { return e; }
+    };
+    Range operator[](int u) const { return {adj.data() + start[u], adj.data() + start[u + 1]}; }
+
+    // order = visit order; dist = BFS distance or DFS depth (-1 unreached);
+    // parent = tree parent (-1 for the root and unreached vertices).
+    struct Traversal { vi order, dist, parent; };
+
+    Traversal bfs(int src) const {
+        Traversal r{{}, vi(n, -1), vi(n, -1)};
+        r.order.reserve(n);
+        r.order.pb(src);
+        r.dist[src] = 0;
+        for (int head = 0; head < sz(r.order); head++) {
+            int u = r.order[head];
+            for (int v : (*this)[u])
+                if (r.dist[v] < 0) {
+                    r.dist[v] = r.dist[u] + 1;
+                    r.parent[v] = u;
+                    r.order.pb(v);
+                }
+        }
+        return r;
+    }
+
+    // Same visit order as the recursive dfs(u), but on an explicit stack of
+    // (vertex, next edge) so depth is limited by memory, not the call stack.
+    Traversal dfs(int src) const {
+        Traversal r{{}, vi(n, -1), vi(n, -1)};
+        vector<pii> st{{src, start[src]}};
+        r.order.pb(src);
+        r.dist[src] = 0;
+        while (!st.empty()) {
+            auto& [u, e] = st.back();
+            if (e == start[u + 1]) { st.pop_back(); continue; }
+            int v = adj[e++];
+            if (r.dist[v] >= 0) continue;
+            r.dist[v] = r.dist[u] + 1;
+            r.parent[v] = u;
+            r.order.pb(v);
+            st.pb({v, start[v]});
+        }
+        return r;
+    }
+};
+
+// ============================================
+// PARALLEL BFS - direction-optimizing (Beamer)
+// ============================================
+// Level-synchronous BFS over an undirected Graph. Small frontiers expand
+// top-down (claim neighbours with an atomic fetch_or on the visited
+// bitmap); once the frontier's edges outweigh the unvisited ones it flips
+// to bottom-up, where each unvisited vertex looks for any parent in the
+// frontier bitmap and stops at the first hit. Returns the same dist as
+// Graph::bfs(src).dist.
+vi parallelBfs(const Graph& g, int src, int threads = threadCount()) {
+    const int n = g.n, words = (n + 63) / 64;
+    const ll ALPHA = 14, BETA = 24;  // switch thresholds from the paper
+    vi dist(n, -1);
+    vector<atomic<ull>> seen(words);
+    vector<ull> front(words), next(words);
+    vi frontier{src};
+    dist[src] = 0;
+    seen[src >> 6] = 1ULL << (src & 63);
+    ll frontEdges = g.deg(src), edgesLeft = sz(g.adj) - frontEdges, nf = 1;
+    bool bottomUp = false;
+
+    vector<vi> localNext(threads);
+    vll localCount(threads), localEdges(threads);
+    for (int level = 1; nf > 0; level++) {
+        if (!bottomUp && frontEdges > edgesLeft / ALPHA) {
+            bottomUp = true;
+            fill(all(front), 0);
+            for (int u : frontier) front[u >> 6] |= 1ULL << (u & 63);
+        } else if (bottomUp && nf < n / BETA) {
+            bottomUp = false;
+            frontier.clear();
+            rep(w, 0, words) for (ull b = front[w]; b; b &= b - 1) frontier.pb(w * 64 + __builtin_ctzll(b));
+        }
+        fill(all(localCount), 0);
+        fill(all(localEdges), 0);
+        int used;
+        if (bottomUp) {
+            // Chunks are whole bitmap words, so next[] needs no atomics.
+            used = parallelChunks(words, 256, [&](ll lo, ll hi, int c) {
+                for (ll w = lo; w < hi; w++) {
+                    ull bits = 0;
+                    for (int v = w * 64, e = min<ll>(n, w * 64 + 64); v < e; v++) {
+                        if (dist[v] >= 0) continue;
+                        for (int u : g[v])
+                            if (front[u >> 6] >> (u & 63) & 1) {
+                                dist[v] = level;
+                                bits |= 1ULL << (v & 63);
+                                localCount[c]++;
+                                localEdges[c] += g.deg(v);
+                                break;
+                            }
+                    }
+                    next[w] = bits;
+                    if (bits) seen[w].fetch_or(bits, memory_order_relaxed);
+                }
+            }, threads);
+            swap(front, next);
+        } else {
+            used = parallelChunks(sz(frontier), 1024, [&](ll lo, ll hi, int c) {
+                vi& out = localNext[c];
+                out.clear();
+                for (ll i = lo; i < hi; i++)
+                    for (int v : g[frontier[i]]) {
+                        ull bit = 1ULL << (v & 63);
+                        if (seen[v >> 6].load(memory_order_relaxed) & bit) continue;
+                        if (seen[v >> 6].fetch_or(bit, memory_order_relaxed) & bit) continue;
+                        dist[v] = level;
+                        out.pb(v);
+                        localEdges[c] += g.deg(v);
+                    }
+                localCount[c] = sz(out);
+            }, threads);
+            frontier.clear();
+            rep(c, 0, used) frontier.insert(frontier.end(), all(localNext[c]));
+        }
+        nf = accumulate(localCount.begin(), localCount.begin() + used, 0LL);
+        frontEdges = accumulate(localEdges.begin(), localEdges.begin() + used, 0LL);
+        edgesLeft -= frontEdges;
+    }
+    return dist;
+}
+
+// ============================================
+// ARENA - per-test-case bump allocator
+// ============================================
+// A std::pmr::memory_resource that hands out memory by bumping a pointer
+// through blocks it keeps forever. deallocate is a no-op and reset() just
+// rewinds to the first block, so once the blocks are big enough for the
+// largest test case, solving makes no heap calls at all.
+struct Arena : pmr::memory_resource {
+    static const size_t FIRST = 1 << 16;
+
+    vector<pair<char*, size_t>> blocks;
+    size_t cur = 0, before = 0;  // current block, bytes handed out in earlier ones
+    char *ptr, *end;
+    ll allocs = 0, heapCalls = 0;
+    size_t peak = 0;
+
+    Arena() { addBlock(FIRST); ptr = blocks[0].first, end = ptr + FIRST; }
+    ~Arena() { for (auto& b : blocks) ::operator delete(b.first); }
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void reset() {  // O(1): keeps every block for the next round
+        cur = before = 0;
+        ptr = blocks[0].first;
+        end = ptr + blocks[0].second;
+    }
+    size_t bytesUsed() const { return before + (ptr - blocks[cur].first); }
+    void report(const char* name) const {
+        fprintf(stderr, "[arena %s] allocs=%lld heap_calls=%lld peak=%zu B blocks=%d\n", name, allocs, heapCalls,
+                peak, sz(blocks));
+    }
+
+private:
+    void addBlock(size_t size) {
+        blocks.pb({(char*)::operator new(size), size});
+        heapCalls++;
+    }
+    static char* alignUp(char* p, size_t align) {
+        return (char*)(((uintptr_t)p + align - 1) & ~(uintptr_t)(align - 1));
+    }
+
+    void* do_allocate(size_t bytes, size_t align) override {
+        allocs++;
+        char* p = alignUp(ptr, align);
+        while ((size_t)(end - p) < bytes || p > end) {  // next kept block, or a bigger new one
+            before += ptr - blocks[cur].first;
+            if (++cur == blocks.size()) addBlock(max(blocks.back().second * 2, bytes + align));
+            ptr = blocks[cur].first;
+            end = ptr + blocks[cur].second;
+            p = alignUp(ptr, align);
+        }
+        ptr = p + bytes;
+        peak = max(peak, bytesUsed());
+        return p;
+    }
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const pmr::memory_resource& o) const noexcept override { return this == &o; }
+};
+
+typedef pmr::vector<int> pvi;
+typedef pmr::vector<ll> pvll;
+
 // ============================================
 // SOLVE FUNCTION - Write your solution here
 // ============================================
-void solve() {
-    // Read input
+// Everything solve() needs for one test case. Reading is kept apart from
+// solving so the parallel driver can parse every case up front. Containers
+// live on the arena the driver passes in.
+struct TestCase {
+    ll sum = 0;  // reduced while parsing
+    pvi arr;     // only filled if the solution needs the values themselves
+    explicit TestCase(Arena& a) : arr(&a) {}
+};
+
+void readCase(Scanner& in, TestCase& tc) {
     int n;
-    cin >> n;
-    
-    vi arr(n);
-    rep(i, 0, n) cin >> arr[i];
+    in >> n;
     
+    // Stream the values instead of storing them; add more reducers as needed
+    // (MinR, MaxR, XorR, HistR), or keep them: auto keep = collect(tc.arr);
+    SumR sum;
+    in.reduce(n, sum);
+    tc.sum = sum.v;
+}
+
+// One random case in the format readCase() expects, for the BENCH-mode
+// solve harness (./a.out solve --n=... --t=...). Keep the two in sync.
+struct InputShape {
+    ll n = 1000, lo = -1000000000, hi = 1000000000;
+    bool varyN = false;  // n uniform in [1, n] instead of fixed
+};
+void genCase(mt19937_64& rng, const InputShape& sh, Out& out) {
+    ll n = sh.varyN ? 1 + rng() % sh.n : sh.n;
+    out << n << '\n';
+    uniform_int_distribution<ll> value(sh.lo, sh.hi);  // hi - lo + 1 may overflow (full ll range)
+    rep(i, 0, n) out << value(rng) << " \n"[i == n - 1];
+}
+
+// Must not touch globals (sc, shared scratch) - may run on any thread.
+// Put scratch containers on `arena`; it is reset after every case:
+//     pvi tmp(n, &arena);  pmr::map<int, int> cnt(&arena);
+void solve(const TestCase& tc, Out& out, Arena& arena) {
+    (void)arena;
     // Your solution here
-    ll sum = 0;
-    for (int x : arr) sum += x;
+    ll sum = tc.sum;
     
     // Output
-    cout << sum << "\n";
+    out << sum << "\n";
+}
+
+// ============================================
+// TEST CASE DRIVERS
+// ============================================
+// -DARENA_STATS prints allocation counts and peak bytes to stderr at exit.
+void runSerial(int t) {
+    Out out;
+    Arena arena;
+    while (t--) {
+        arena.reset();
+        TestCase tc(arena);
+        readCase(sc, tc);
+        solve(tc, out, arena);
+        if (out.buf.size() > (1 << 16)) out.flush();
+    }
+    out.flush();
+#ifdef ARENA_STATS
+    arena.report("serial");
+#endif
+}
+
+// Parses all t cases (onto one input arena), then solves them on a thread
+// pool. Workers claim blocks of cases and append to their own Out and
+// scratch Arena; each block remembers where its text landed so the results
+// are written back in input order.
+void runParallel(int t, int threads = threadCount()) {
+    Arena input;
+    vector<TestCase> cases;
+    cases.reserve(t);
+    rep(i, 0, t) readCase(sc, cases.emplace_back(input));
+
+    const int BLOCK = 16;
+    int blocks = (t + BLOCK - 1) / BLOCK;
+    threads = max(1, min(threads, blocks));
+    struct Span { int thread; size_t lo, hi; };
+    vector<Span> spans(blocks);
+    vector<Out> outs(threads);
+    vector<Arena> scratch(threads);
+    atomic<int> next(0);
+
+    auto work = [&](int id) {
+        Out& out = outs[id];
+        for (int b; (b = next.fetch_add(1, memory_order_relaxed)) < blocks;) {
+            size_t lo = out.buf.size();
+            for (int i = b * BLOCK; i < min(t, (b + 1) * BLOCK); i++) {
+                scratch[id].reset();
+                solve(cases[i], out, scratch[id]);
+            }
+            spans[b] = {id, lo, out.buf.size()};
+        }
+    };
+    vector<thread> pool;
+    rep(i, 1, threads) pool.emplace_back(work, i);
+    work(0);
+    for (auto& th : pool) th.join();
+
+    for (const Span& sp : spans)
+        writeAll(1, outs[sp.thread].buf.data() + sp.lo, sp.hi - sp.lo);
+#ifdef ARENA_STATS
+    input.report("input");
+    rep(i, 0, threads) scratch[i].report("scratch");
+#endif
+}
+
+#ifdef BENCH
+// ============================================
+// BENCHMARKS - g++ -O2 -DBENCH <file> && ./a.out [name ...]
+// ============================================
+double nowSec() {
+    return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// 10^7 ints through cin (the old solve() path) vs Scanner in both modes.
+void benchScanner() {
+    const int N = 10000000;
+    const char* path = "/tmp/dsa_bench_scanner.txt";
+    FILE* f = fopen(path, "w");
+    mt19937 rng(12345);
+    fprintf(f, "%d\n", N);
+    rep(i, 0, N) fprintf(f, "%d ", (int)(rng() % 2000000001u) - 1000000000);
+    fclose(f);
+
+    auto report = [&](const char* name, double secs, ll sum) {
+        printf("  %-12s %8.3f s  %8.1f Mtok/s  sum=%lld\n", name, secs, N / secs / 1e6, sum);
+    };
+
+    {
+        FILE* r = freopen(path, "r", stdin);
+        (void)r;
+        fastIO();
+        double t0 = nowSec();
+        int n;
+        cin >> n;
+        ll sum = 0;
+        rep(i, 0, n) { int x; cin >> x; sum += x; }
+        report("cin", nowSec() - t0, sum);
+    }
+    for (bool useMap : {true, false}) {
+        int fd = open(path, O_RDONLY);
+        double t0 = nowSec();
+        Scanner s(fd, useMap);
+        int n;
+        s >> n;
+        ll sum = 0;
+        rep(i, 0, n) sum += s.readInt();
+        report(useMap ? "Scanner/mmap" : "Scanner/read", nowSec() - t0, sum);
+        close(fd);
+    }
+    remove(path);
+}
+
+// 10^8 dependent modular multiplies: runtime-mod % (old power()) vs mint.
+void benchModint() {
+    const int N = 100000000;
+    volatile ll modSink = MOD;  // power() took mod at runtime
+    ll mod = modSink;
+    {
+        double t0 = nowSec();
+        ll x = 1, y = 123456789;
+        rep(i, 0, N) x = x * y % mod;
+        double t = nowSec() - t0;
+        printf("  %-17s %7.3f s  %7.2f ns/mul  x=%lld\n", "ll % runtime", t, t / N * 1e9, x);
+    }
+    {
+        double t0 = nowSec();
+        ll x = 1, y = 123456789;
+        rep(i, 0, N) x = x * y % MOD;
+        double t = nowSec() - t0;
+        printf("  %-17s %7.3f s  %7.2f ns/mul  x=%lld\n", "ll % const", t, t / N * 1e9, x);
+    }
+    {
+        double t0 = nowSec();
+        mint x = 1, y = 123456789;
+        rep(i, 0, N) x *= y;
+        double t = nowSec() - t0;
+        printf("  %-17s %7.3f s  %7.2f ns/mul  x=%u\n", "mint (Montgomery)", t, t / N * 1e9, x.val());
+    }
+    {
+        double t0 = nowSec();
+        modint<998244352> x = 1, y = 123456789;
+        rep(i, 0, N) x *= y;
+        double t = nowSec() - t0;
+        printf("  %-17s %7.3f s  %7.2f ns/mul  x=%u\n", "modint (Barrett)", t, t / N * 1e9, x.val());
+    }
+
+    // Independent multiplies (throughput, what table/convolution loops see).
+    const int L = 1 << 16, R = N / L;
+    vll a(L), b(L);
+    vector<mint> ma(L), mb(L);
+    rep(i, 0, L) ma[i] = a[i] = i + 1, mb[i] = b[i] = 3 * i + 7;
+    {
+        double t0 = nowSec();
+        rep(r, 0, R) rep(i, 0, L) a[i] = a[i] * b[i] % mod;
+        double t = nowSec() - t0;
+        printf("  %-17s %7.3f s  %7.2f ns/mul  (independent)\n", "ll % runtime", t, t / N * 1e9);
+    }
+    {
+        double t0 = nowSec();
+        rep(r, 0, R) rep(i, 0, L) ma[i] *= mb[i];
+        double t = nowSec() - t0;
+        printf("  %-17s %7.3f s  %7.2f ns/mul  (independent, %s)\n", "mint (Montgomery)", t,
+               t / N * 1e9, a[L - 1] == ma[L - 1].val() ? "match" : "MISMATCH");
+    }
+
+    const int K = 1000000;
+    mt19937_64 rng(7);
+    vll exps(K);
+    for (ll& e : exps) e = (ll)rng();  // both signs: e < 0 must give 1 like power()
+    ll chk = 0;
+    double t0 = nowSec();
+    for (ll e : exps) {
+        ll r = 1, b = 3, x = e;  // the pre-modint power() loop
+        for (; x > 0; x >>= 1, b = b * b % mod)
+            if (x & 1) r = r * b % mod;
+        chk += r;
+    }
+    double tOld = nowSec() - t0;
+    t0 = nowSec();
+    vll got = power_many(3, exps);
+    double tMany = nowSec() - t0;
+    ll chk2 = accumulate(all(got), 0LL);
+    printf("  10^6 x pow: old loop %.3f s, power_many %.3f s (%s)\n", tOld, tMany,
+           chk == chk2 ? "match" : "MISMATCH");
+    vll few = {5, -3, 0, -1, LLONG_MIN, LLONG_MAX, 1000000006};  // the short-list path
+    vll fewGot = power_many(3, few);
+    bool ok = true;
+    rep(i, 0, sz(few)) ok &= fewGot[i] == power(3, few[i]);
+    printf("  mixed-sign exponents, short list: %s\n", ok ? "match" : "MISMATCH");
 }
 
-int main() {
+// 10^7 random pairs through the old recursive Euclid, __gcd and Stein gcd.
+ll gcdEuclid(ll a, ll b) { return b == 0 ? a : gcdEuclid(b, a % b); }
+
+void benchGcd() {
+    const int N = 10000000;
+    mt19937_64 rng(99);
+    vll a(N), b(N);
+    rep(i, 0, N) a[i] = rng() >> 2, b[i] = rng() >> 2;
+    auto run = [&](const char* name, auto g) {
+        double t0 = nowSec();
+        ll chk = 0;
+        rep(i, 0, N) chk += g(a[i], b[i]);
+        double t = nowSec() - t0;
+        printf("  %-14s %7.3f s  %6.1f ns/gcd  chk=%lld\n", name, t, t / N * 1e9, chk);
+    };
+    run("old gcd()", gcdEuclid);
+    run("__gcd", [](ll x, ll y) { return __gcd(x, y); });
+    run("binary gcd", [](ll x, ll y) { return gcd(x, y); });
+
+    // Multiples of 6 so gcd_many can't stop early at 1.
+    vll v(8 * GCD_PAR_MIN);
+    for (ll& x : v) x = 6 * (ll)(rng() >> 8);
+    double t0 = nowSec();
+    ll g1 = 0;
+    for (ll x : v) g1 = gcdEuclid(g1, x);
+    double tSerial = nowSec() - t0;
+    t0 = nowSec();
+    ll g2 = gcd_many(v);
+    double tMany = nowSec() - t0;
+    printf("  gcd over %d: old %.3f s, gcd_many %.3f s on %d threads (%lld, %lld)\n", sz(v), tSerial,
+           tMany, threadCount(), g1, g2);
+}
+
+// 4000x4000 grid, ~25% walls: queue<pii> + isValid vs Grid<4>::bfs.
+void benchGrid() {
+    const int n = 4000, m = 4000;
+    mt19937 rng(5);
+    vector<string> raw(n, string(m, '.'));
+    for (auto& row : raw) for (char& c : row) if (rng() % 4 == 0) c = '#';
+    raw[0][0] = '.';
+
+    double t0 = nowSec();
+    vvi dist(n, vi(m, -1));
+    queue<pii> q;
+    q.push({0, 0});
+    dist[0][0] = 0;
+    while (!q.empty()) {
+        auto [x, y] = q.front();
+        q.pop();
+        rep(d, 0, 4) {
+            int nx = x + dx[d], ny = y + dy[d];
+            if (isValid(nx, ny, n, m) && raw[nx][ny] != '#' && dist[nx][ny] == -1) {
+                dist[nx][ny] = dist[x][y] + 1;
+                q.push({nx, ny});
+            }
+        }
+    }
+    double tOld = nowSec() - t0;
+    ll sumOld = 0;
+    for (auto& row : dist) for (int d : row) sumOld += d;
+
+    Grid<4> g(n, m);
+    rep(x, 0, n) g.setRow(x, raw[x]);
+    t0 = nowSec();
+    vi flat = g.bfs(0, 0);
+    double tNew = nowSec() - t0;
+    ll sumNew = 0;
+    rep(x, 0, n) rep(y, 0, m) sumNew += flat[g.id(x, y)];
+    printf("  queue<pii>+isValid %.3f s, Grid::bfs %.3f s (%.1fx, %s)\n", tOld, tNew, tOld / tNew,
+           sumOld == sumNew ? "match" : "MISMATCH");
+}
+
+// Heap bytes in use, including mmap'd blocks (glibc).
+ll heapBytes() {
+    struct mallinfo2 mi = mallinfo2();
+    return (ll)(mi.uordblks + mi.hblkhd);
+}
+
+// 10^6 vertices, 10^7 undirected edges: vvi vs CSR memory, BFS and DFS.
+void benchGraph() {
+    const int n = 1000000, m = 10000000;
+    mt19937 rng(17);
+    vpii edges(m);
+    for (auto& [u, v] : edges) u = rng() % n, v = rng() % n;
+
+    ll h0 = heapBytes();
+    double t0 = nowSec();
+    vvi adj(n);
+    for (auto [u, v] : edges) adj[u].pb(v), adj[v].pb(u);
+    double tBuildOld = nowSec() - t0;
+    ll memOld = heapBytes() - h0;
+
+    t0 = nowSec();
+    vi dist(n, -1);
+    queue<int> q;
+    q.push(0);
+    dist[0] = 0;
+    while (!q.empty()) {
+        int u = q.front();
+        q.pop();
+        for (int v : adj[u]) if (dist[v] < 0) dist[v] = dist[u] + 1, q.push(v);
+    }
+    double tBfsOld = nowSec() - t0;
+    adj = vvi();
+
+    h0 = heapBytes();
+    t0 = nowSec();
+    Graph g(n, edges);
+    double tBuildNew = nowSec() - t0;
+    ll memNew = heapBytes() - h0;
+    t0 = nowSec();
+    Graph::Traversal r = g.bfs(0);
+    double tBfsNew = nowSec() - t0;
+    t0 = nowSec();
+    Graph::Traversal d = g.dfs(0);
+    double tDfs = nowSec() - t0;
+
+    t0 = nowSec();
+    vi pd = parallelBfs(g, 0);
+    double tPar = nowSec() - t0;
+
+    printf("  vvi: %6.1f MB  build %.3f s  bfs %.3f s\n", memOld / 1e6, tBuildOld, tBfsOld);
+    printf("  CSR: %6.1f MB  build %.3f s  bfs %.3f s  dfs %.3f s (depth %d)  %s\n", memNew / 1e6,
+           tBuildNew, tBfsNew, tDfs, *max_element(all(d.dist)), dist == r.dist ? "match" : "MISMATCH");
+    printf("  parallelBfs on %d threads: %.3f s (%.1fx vs CSR bfs, %s)\n", threadCount(), tPar,
+           tBfsNew / tPar, pd == r.dist ? "match" : "MISMATCH");
+}
+
+// N = 10^7 tables: one inverse + O(N) vs power(i, MOD-2) per element.
+void benchCombinatorics() {
+    const int N = 10000000;
+    constexpr Combinatorics<1000> small;  // compile-time table
+    static_assert(small.nCr(10, 3).val() == 120 && small.catalan(5).val() == 42);
+
+    double t0 = nowSec();
+    vll fact(N + 1), invFact(N + 1);
+    fact[0] = 1;
+    rep(i, 1, N + 1) fact[i] = fact[i - 1] * i % MOD;
+    rep(i, 0, N + 1) invFact[i] = power(fact[i], MOD - 2);
+    double tOld = nowSec() - t0;
+
+    t0 = nowSec();
+    auto* C = new Combinatorics<N>();
+    double tNew = nowSec() - t0;
+    bool same = true;
+    rep(i, 0, N + 1) same &= C->invFact[i].val() == invFact[i];
+    printf("  N=%d: per-element power %.3f s, Combinatorics %.3f s (%.1fx, %s)\n", N, tOld, tNew,
+           tOld / tNew, same ? "match" : "MISMATCH");
+    printf("  tables: %.1f MB (Combinatorics<%d>), %zu bytes (constexpr Combinatorics<1000>)\n",
+           C->bytes() / 1e6, N, small.bytes());
+    ll chk = 0;
+    t0 = nowSec();
+    rep(i, 0, N) chk += C->nCr(N, i).val();
+    printf("  10^7 nCr lookups %.3f s (chk %lld)\n", nowSec() - t0, chk);
+    delete C;
+}
+
+// Schoolbook vs convolve at 2^15, then degree-10^6 products for both moduli.
+void benchNtt() {
+    mt19937_64 rng(23);
+    auto randPoly = [&](int n) { vll p(n); for (ll& x : p) x = rng() % MOD; return p; };
+    {
+        vll a = randPoly(1 << 15), b = randPoly(1 << 15), ref(2 * sz(a) - 1);
+        double t0 = nowSec();
+        rep(i, 0, sz(a)) rep(j, 0, sz(b)) ref[i + j] = (ref[i + j] + a[i] * b[j]) % MOD;
+        double tSlow = nowSec() - t0;
+        t0 = nowSec();
+        vll got = convolve(a, b);
+        double tFast = nowSec() - t0;
+        printf("  n=2^15: schoolbook %.3f s, convolve %.4f s (%s)\n", tSlow, tFast, got == ref ? "match" : "MISMATCH");
+    }
+    vll a = randPoly(1000000), b = randPoly(1000000);
+    for (ll mod : {998244353LL, (ll)MOD}) {
+        double t0 = nowSec();
+        vll c = convolve(a, b, mod);
+        printf("  n=10^6 mod %lld: %.3f s\n", mod, nowSec() - t0);
+    }
+}
+
+// 10^5 cases of scratch-heavy work (vector, map, vector of vectors):
+// global heap vs one Arena reset per case.
+template <class Vec, class Map, class VV>
+ll scratchWork(const int* data, int n, Vec v, Map cnt, VV buckets) {
+    rep(i, 0, n) v.pb(data[i]);
+    for (int x : v) cnt[x]++;
+    buckets.resize(16);
+    for (int x : v) buckets[x % 16].pb(x);
+    ll r = 0;
+    for (auto& [k, c] : cnt) r += k * c;
+    for (auto& b : buckets) r += sz(b);
+    return r;
+}
+
+void benchArena() {
+    const int T = 100000;
+    mt19937 rng(31);
+    vi sizes(T), data(256);
+    for (int& n : sizes) n = 1 + rng() % 200;
+    for (int& x : data) x = rng() % 64;
+
+    double t0 = nowSec();
+    ll chk1 = 0;
+    for (int n : sizes) chk1 += scratchWork(data.data(), n, vi(), map<int, int>(), vvi());
+    double tHeap = nowSec() - t0;
+
+    Arena arena;
+    ll chk2 = 0, warmCalls = 0;
+    t0 = nowSec();
+    rep(i, 0, T) {
+        arena.reset();
+        chk2 += scratchWork(data.data(), sizes[i], pvi(&arena), pmr::map<int, int>(&arena),
+                            pmr::vector<pvi>(&arena));
+        if (i == T / 10) warmCalls = arena.heapCalls;
+    }
+    double tArena = nowSec() - t0;
+    printf("  heap %.3f s, arena %.3f s (%.1fx, %s)\n", tHeap, tArena, tHeap / tArena,
+           chk1 == chk2 ? "match" : "MISMATCH");
+    printf("  arena: %lld allocs, %lld heap calls (%lld after first 10%% of cases), peak %zu B\n",
+           arena.allocs, arena.heapCalls, arena.heapCalls - warmCalls, arena.peak);
+}
+
+ll rssBytes() {
+    ll pages = 0, resident = 0;
+    if (FILE* f = fopen("/proc/self/statm", "r")) {
+        if (fscanf(f, "%lld %lld", &pages, &resident) != 2) resident = 0;
+        fclose(f);
+    }
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+// 3*10^7 ints from a file: materialize-then-sum (old solve()) vs streaming
+// reduce with several reducers. Memory is RSS growth during each pass.
+void benchReduce() {
+    const int N = 30000000;
+    const char* path = "/tmp/dsa_bench_reduce.txt";
+    FILE* f = fopen(path, "w");
+    mt19937 rng(77);
+    fprintf(f, "%d\n", N);
+    rep(i, 0, N) fprintf(f, "%d ", (int)(rng() % 2000000001u) - 1000000000);
+    fclose(f);
+
+    for (bool useMap : {true, false}) {
+        int fd = open(path, O_RDONLY);
+        Scanner s(fd, useMap);
+        ll r0 = rssBytes();
+        double t0 = nowSec();
+        int n;
+        s >> n;
+        SumR sum;
+        MinR mn;
+        MaxR mx;
+        XorR x;
+        HistR h(-10, 10);
+        s.reduce(n, sum, mn, mx, x, h);
+        double t = nowSec() - t0;
+        printf("  reduce/%s  %.3f s  %6.1f Mint/s  +%.1f MB RSS  sum=%lld min=%lld max=%lld\n",
+               useMap ? "mmap" : "read", t, N / t / 1e6, (rssBytes() - r0) / 1e6, sum.v, mn.v, mx.v);
+        close(fd);
+    }
+    {
+        int fd = open(path, O_RDONLY);
+        Scanner s(fd);
+        ll r0 = rssBytes();
+        double t0 = nowSec();
+        int n;
+        s >> n;
+        vi arr(n);
+        rep(i, 0, n) s >> arr[i];
+        ll sum = 0;
+        for (int v : arr) sum += v;
+        double t = nowSec() - t0;
+        printf("  vi + sum     %.3f s  %6.1f Mint/s  +%.1f MB RSS  sum=%lld\n", t, N / t / 1e6,
+               (rssBytes() - r0) / 1e6, sum);
+        close(fd);
+    }
+    remove(path);
+}
+
+// Per-event cost: traceRecord (what dbg() does under -DLOCAL) vs the old
+// cerr-style macro, whose endl flushes every call (sent to /dev/null here).
+void benchTrace() {
+    const int N = 10000000, OLD = 200000;
+    double t0 = nowSec();
+    rep(i, 0, N) traceRecord("i", i);
+    double tNew = (nowSec() - t0) / N;
+    ull sink = 0;
+    t0 = nowSec();
+    rep(i, 0, N) sink += traceClock();
+    double tClock = (nowSec() - t0) / N;
+    ofstream devnull("/dev/null");
+    t0 = nowSec();
+    rep(i, 0, OLD) devnull << "i" << " = " << i << endl;
+    double tOld = (nowSec() - t0) / OLD;
+    printf("  traceRecord %.1f ns/event (timestamp alone %.1f ns), old dbg (endl) %.1f ns/event (%.0fx)\n",
+           tNew * 1e9, tClock * 1e9, tOld * 1e9, tOld / tNew);
+    (void)sink;
+    TraceRing& r = traceRing();
+    r.shown = r.head.load();  // nothing to print at exit
+}
+
+// ============================================
+// SOLVE HARNESS - ./a.out solve [--key=value ...]
+// ============================================
+// Generates t seeded cases with genCase(), then times readCase + solve per
+// case, as runSerial does, for `reps` passes over the same input.
+//   --t=10000 --n=1000 --lo=-1e9 --hi=1e9 --vary=0 --seed=1 --reps=5
+//   --json=out.json        write the metrics
+//   --baseline=base.json   compare; exit 1 if wall/p50/p99 grew > --tol (0.10)
+double jsonNumber(const string& js, const string& key) {
+    size_t at = js.find("\"" + key + "\":");
+    return at == string::npos ? NAN : strtod(js.c_str() + at + key.size() + 3, nullptr);
+}
+
+int benchSolve(int argc, char** argv) {
+    map<string, string> opt;
+    rep(i, 2, argc) {
+        string a = argv[i];
+        size_t eq = a.find('=');
+        if (a.rfind("--", 0) == 0 && eq != string::npos) opt[a.substr(2, eq - 2)] = a.substr(eq + 1);
+    }
+    auto num = [&](const string& k, double def) { return opt.count(k) ? stod(opt[k]) : def; };
+    InputShape sh;
+    sh.n = (ll)num("n", sh.n), sh.lo = (ll)num("lo", sh.lo), sh.hi = (ll)num("hi", sh.hi);
+    sh.varyN = num("vary", 0) != 0;
+    int t = (int)num("t", 10000), reps = max(1, (int)num("reps", 5));
+    ull seed = (ull)num("seed", 1);
+    double tol = num("tol", 0.10);
+
+    string path = "/tmp/dsa_bench_solve_" + to_string(getpid()) + ".txt";
+    {
+        mt19937_64 rng(seed);
+        Out gen;
+        gen << t << '\n';
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        rep(i, 0, t) {
+            genCase(rng, sh, gen);
+            if (gen.buf.size() > (1 << 20)) gen.flush(fd);
+        }
+        gen.flush(fd);
+        close(fd);
+    }
+    struct stat st;
+    stat(path.c_str(), &st);
+
+    vll lat;
+    lat.reserve((ll)t * reps);
+    vector<double> walls;
+    for (int r = 0; r < reps; r++) {
+        int fd = open(path.c_str(), O_RDONLY);
+        Scanner in(fd);
+        Arena arena;
+        Out out;
+        int tt;
+        in >> tt;
+        double t0 = nowSec();
+        rep(i, 0, tt) {
+            auto c0 = chrono::steady_clock::now();
+            arena.reset();
+            TestCase tc(arena);
+            readCase(in, tc);
+            solve(tc, out, arena);
+            out.buf.clear();
+            lat.pb(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - c0).count());
+        }
+        walls.pb(nowSec() - t0);
+        close(fd);
+    }
+    remove(path.c_str());
+
+    sort(all(walls));
+    sort(all(lat));
+    auto pct = [&](double q) { return (double)lat[min<ll>(sz(lat) - 1, (ll)(q * sz(lat)))]; };
+    vector<pair<string, double>> m = {
+        {"wall_s", walls[reps / 2]},  // median pass
+        {"cases_per_s", t / walls[reps / 2]},
+        {"mb_per_s", st.st_size / walls[reps / 2] / 1e6},
+        {"p50_ns", pct(0.50)},
+        {"p99_ns", pct(0.99)},
+        {"max_ns", (double)lat.back()},
+    };
+    printf("  t=%d n=%lld%s values=[%lld, %lld] seed=%llu reps=%d input=%.1f MB\n", t, sh.n,
+           sh.varyN ? " (varied)" : "", sh.lo, sh.hi, seed, reps, st.st_size / 1e6);
+    for (auto& [k, v] : m) printf("  %-12s %14.3f\n", k.c_str(), v);
+
+    if (opt.count("json")) {
+        FILE* f = fopen(opt["json"].c_str(), "w");
+        if (!f) { perror("json"); return 2; }
+        fprintf(f, "{\n  \"bench\": \"solve\",\n  \"t\": %d,\n  \"n\": %lld,\n  \"lo\": %lld,\n  \"hi\": %lld,\n"
+                   "  \"vary\": %d,\n  \"seed\": %llu,\n  \"reps\": %d",
+                t, sh.n, sh.lo, sh.hi, (int)sh.varyN, seed, reps);
+        for (auto& [k, v] : m) fprintf(f, ",\n  \"%s\": %.6g", k.c_str(), v);
+        fprintf(f, "\n}\n");
+        fclose(f);
+    }
+
+    int status = 0;
+    if (opt.count("baseline")) {
+        ifstream bf(opt["baseline"]);
+        if (!bf) { perror("baseline"); return 2; }
+        string js((istreambuf_iterator<char>(bf)), istreambuf_iterator<char>());
+        printf("  vs baseline %s (tolerance %.0f%%):\n", opt["baseline"].c_str(), tol * 100);
+        double shape[][2] = {{jsonNumber(js, "t"), (double)t},   {jsonNumber(js, "n"), (double)sh.n},
+                             {jsonNumber(js, "lo"), (double)sh.lo}, {jsonNumber(js, "hi"), (double)sh.hi},
+                             {jsonNumber(js, "vary"), (double)sh.varyN}, {jsonNumber(js, "seed"), (double)seed}};
+        for (auto& [b, c] : shape)
+            if (b != c) { printf("  warning: input shape differs from the baseline's\n"); break; }
+        for (const char* k : {"wall_s", "p50_ns", "p99_ns"}) {
+            double base = jsonNumber(js, k), cur = 0;
+            for (auto& [mk, v] : m) if (mk == k) cur = v;
+            if (!(base > 0)) continue;
+            double change = cur / base - 1;
+            bool bad = change > tol;
+            status |= bad;
+            printf("  %-12s %+7.1f%%%s\n", k, change * 100, bad ? "  REGRESSION" : "");
+        }
+    }
+    return status;
+}
+
+int runBenchmarks(int argc, char** argv) {
+    if (argc >= 2 && !strcmp(argv[1], "solve")) {
+        printf("[solve]\n");
+        return benchSolve(argc, argv);
+    }
+    struct Case { const char* name; void (*run)(); };
+    static const Case cases[] = {
+        {"scanner", benchScanner},
+        {"modint", benchModint},
+        {"gcd", benchGcd},
+        {"grid", benchGrid},
+        {"graph", benchGraph},
+        {"combinatorics", benchCombinatorics},
+        {"ntt", benchNtt},
+        {"arena", benchArena},
+        {"reduce", benchReduce},
+        {"trace", benchTrace},
+    };
+    for (const Case& c : cases) {
+        bool pick = argc < 2;
+        rep(i, 1, argc) if (!strcmp(argv[i], c.name)) pick = true;
+        if (!pick) continue;
+        printf("[%s]\n", c.name);
+        c.run();
+        fflush(stdout);
+    }
+    return 0;
+}
+#endif
+
+int main(int argc, char** argv) {
+#ifdef BENCH
+    return runBenchmarks(argc, argv);
+#endif
+    (void)argc, (void)argv;
     fastIO();
     
     int t = 1;
-    // cin >> t;  // Uncomment for multiple test cases
+    // sc >> t;  // Uncomment for multiple test cases
     
-    while (t--) {
-        solve();
-    }
+#ifdef PARALLEL_TESTS  // -DPARALLEL_TESTS: independent cases on all cores
+    runParallel(t);
+#else
+    runSerial(t);
+#endif
     
     return 0;
 }
@@ -155,4 +1866,9 @@ int main() {
  *         if (!vis[v]) dfs(v);
  *     }
  * }
+ * 
+ * CSR GRAPH (large inputs, deep DFS):
+ * Graph g(n, edges);            // vpii edges, 0-indexed
+ * auto r = g.bfs(0);            // r.dist, r.parent, r.order
+ * for (int v : g[u]) { ... }
  */